@@ -11,7 +11,9 @@ public class GraphicsTools : ModuleRules
 
 		PublicDependencyModuleNames.AddRange(new string[]
 		{
-			"Core"
+			"Core",
+			"HeadMountedDisplay",
+			"InputCore"
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[]
@@ -20,6 +22,7 @@ public class GraphicsTools : ModuleRules
 			"Engine",
 			"Slate",
 			"SlateCore",
+			"DeveloperSettings",
 			"Projects",
 			"RenderCore",
 			"RHI"
@@ -3,6 +3,7 @@
 
 #include "GTClippingBoxComponent.h"
 
+#include "GTClippingFunctionLibrary.h"
 #include "GTWorldSubsystem.h"
 
 #include "Engine/World.h"
@@ -22,7 +23,18 @@ UGTClippingBoxComponent::UGTClippingBoxComponent()
 	}
 }
 
-TArray<UGTSceneComponent*>& UGTClippingBoxComponent::GetWorldComponents()
+FGTComponentSlots& UGTClippingBoxComponent::GetWorldComponents()
 {
-	return GetWorld()->GetSubsystem<UGTWorldSubsystem>()->ClippingBoxes;
+	return GetWorldSubsystem()->ClippingBoxes;
+}
+
+float UGTClippingBoxComponent::CalculateSignedDistance(const FVector& Point) const
+{
+	return UGTClippingFunctionLibrary::PointVsBox(Point, GetCachedInverseTransform(), GetClippingSideSign());
+}
+
+void UGTClippingBoxComponent::CalculateSignedDistances(
+	TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, TArrayView<float> OutDistances) const
+{
+	UGTClippingFunctionLibrary::PointsVsBox(X, Y, Z, GetCachedInverseTransform(), GetClippingSideSign(), OutDistances);
 }
@@ -3,6 +3,7 @@
 
 #include "GTClippingConeComponent.h"
 
+#include "GTClippingFunctionLibrary.h"
 #include "GTWorldSubsystem.h"
 
 #include "Engine/World.h"
@@ -14,19 +15,20 @@ UGTClippingConeComponent::UGTClippingConeComponent()
 		SetSettingsParameterName(ParameterName);
 	}
 	{
-		static const FName ParameterNames[2] = {"ClippingConeStart", "ClippingConeEnd"};
+		// The invariants are not part of MPC_GTSettings, they can be named when using a ParameterCollectionOverride.
+		static const FName ParameterNames[4] = {"ClippingConeStart", "ClippingConeEnd", NAME_None, NAME_None};
 		TArray<FName> Names;
 		Names.Append(ParameterNames, UE_ARRAY_COUNT(ParameterNames));
 		SetTransformColumnParameterNames(Names);
 	}
 }
 
-TArray<UGTSceneComponent*>& UGTClippingConeComponent::GetWorldComponents()
+FGTComponentSlots& UGTClippingConeComponent::GetWorldComponents()
 {
-	return GetWorld()->GetSubsystem<UGTWorldSubsystem>()->ClippingCones;
+	return GetWorldSubsystem()->ClippingCones;
 }
 
-void UGTClippingConeComponent::UpdateParameterCollectionTransform()
+void UGTClippingConeComponent::CalculateTransformColumns(FLinearColor* Columns) const
 {
 	const FTransform& Transform = GetComponentTransform();
 
@@ -35,6 +37,30 @@ void UGTClippingConeComponent::UpdateParameterCollectionTransform()
 	FVector Bottom = Transform.GetLocation() - HalfHeight;
 	FVector ScaleBottomTop = Transform.GetScale3D() * 0.5f;
 
-	SetVectorParameterValue(GetTransformColumnParameterNames()[0], FLinearColor(Top.X, Top.Y, Top.Z, ScaleBottomTop.Z));
-	SetVectorParameterValue(GetTransformColumnParameterNames()[1], FLinearColor(Bottom.X, Bottom.Y, Bottom.Z, ScaleBottomTop.Y));
+	Columns[0] = FLinearColor(Top.X, Top.Y, Top.Z, ScaleBottomTop.Z);
+	Columns[1] = FLinearColor(Bottom.X, Bottom.Y, Bottom.Z, ScaleBottomTop.Y);
+
+	// Invariants of GTPointVsCone: ba = b - a and 1 / baba, then rba = rb - ra, baba = dot(ba, ba), and 1 / k = 1 / (rba * rba + baba).
+	const FVector BA = Bottom - Top;
+	const float BABA = BA.SizeSquared();
+	const float RBA = ScaleBottomTop.Y - ScaleBottomTop.Z;
+	const float K = (RBA * RBA) + BABA;
+
+	Columns[2] = FLinearColor(BA.X, BA.Y, BA.Z, BABA > 0 ? 1 / BABA : 0);
+	Columns[3] = FLinearColor(RBA, BABA, K > 0 ? 1 / K : 0, 0);
+}
+
+float UGTClippingConeComponent::CalculateSignedDistance(const FVector& Point) const
+{
+	const FLinearColor* Columns = GetTransformColumns();
+
+	return UGTClippingFunctionLibrary::PointVsCone(Point, FVector4(Columns[0]), FVector4(Columns[1]), GetClippingSideSign());
+}
+
+void UGTClippingConeComponent::CalculateSignedDistances(
+	TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, TArrayView<float> OutDistances) const
+{
+	const FLinearColor* Columns = GetTransformColumns();
+
+	UGTClippingFunctionLibrary::PointsVsCone(X, Y, Z, FVector4(Columns[0]), FVector4(Columns[1]), GetClippingSideSign(), OutDistances);
 }
@@ -0,0 +1,187 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "GTClippingCullingComponent.h"
+
+#include "GTClippingFunctionLibrary.h"
+#include "GTWorldSubsystem.h"
+#include "GraphicsTools.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+void UGTClippingCullingComponent::SetHideClippedPrimitives(bool Hide)
+{
+	if (bHideClippedPrimitives != Hide)
+	{
+		bHideClippedPrimitives = Hide;
+
+		if (!bHideClippedPrimitives)
+		{
+			for (FGTClippingCullingState& State : Primitives)
+			{
+				SetPrimitiveHidden(State, false);
+			}
+		}
+	}
+}
+
+void UGTClippingCullingComponent::SetUnclippedMaterials(const TMap<UMaterialInterface*, UMaterialInterface*>& Materials)
+{
+	// Restore the original materials so that the next update swaps to the new variants.
+	for (FGTClippingCullingState& State : Primitives)
+	{
+		SetPrimitiveUnclipped(State, false);
+	}
+
+	UnclippedMaterials = Materials;
+}
+
+void UGTClippingCullingComponent::RefreshPrimitives()
+{
+	RestorePrimitives();
+	Primitives.Reset();
+
+	if (AActor* Owner = GetOwner())
+	{
+		TInlineComponentArray<UPrimitiveComponent*> OwnerPrimitives(Owner);
+
+		for (UPrimitiveComponent* Primitive : OwnerPrimitives)
+		{
+			FGTClippingCullingState& State = Primitives.AddDefaulted_GetRef();
+			State.Primitive = Primitive;
+		}
+	}
+}
+
+void UGTClippingCullingComponent::UpdateCulling()
+{
+	for (FGTClippingCullingState& State : Primitives)
+	{
+		UPrimitiveComponent* Primitive = State.Primitive.Get();
+
+		if (Primitive == nullptr || !Primitive->IsRegistered())
+		{
+			continue;
+		}
+
+		const bool Clipped = bHideClippedPrimitives &&
+							 UGTClippingFunctionLibrary::IsBoundsClipped(this, Primitive->Bounds, ClippingGroupMask, ClippingPrimitiveTypes);
+		SetPrimitiveHidden(State, Clipped);
+
+		if (!Clipped && UnclippedMaterials.Num() != 0)
+		{
+			SetPrimitiveUnclipped(
+				State, UGTClippingFunctionLibrary::IsBoundsUnclipped(this, Primitive->Bounds, ClippingGroupMask, ClippingPrimitiveTypes));
+		}
+	}
+}
+
+void UGTClippingCullingComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	UWorld* World = GetWorld();
+
+	// Culling alters primitive state which should never be saved into a level.
+	if (World != nullptr && World->IsGameWorld())
+	{
+		RefreshPrimitives();
+
+		if (UGTWorldSubsystem* Subsystem = World->GetSubsystem<UGTWorldSubsystem>())
+		{
+			Subsystem->AddClippingCullingComponent(this);
+		}
+	}
+}
+
+void UGTClippingCullingComponent::OnUnregister()
+{
+	Super::OnUnregister();
+
+	if (UWorld* World = GetWorld())
+	{
+		if (UGTWorldSubsystem* Subsystem = World->GetSubsystem<UGTWorldSubsystem>())
+		{
+			Subsystem->RemoveClippingCullingComponent(this);
+		}
+	}
+
+	RestorePrimitives();
+	Primitives.Reset();
+}
+
+void UGTClippingCullingComponent::RestorePrimitives()
+{
+	for (FGTClippingCullingState& State : Primitives)
+	{
+		SetPrimitiveHidden(State, false);
+		SetPrimitiveUnclipped(State, false);
+	}
+}
+
+void UGTClippingCullingComponent::SetPrimitiveHidden(FGTClippingCullingState& State, bool Hidden)
+{
+	UPrimitiveComponent* Primitive = State.Primitive.Get();
+
+	if (Primitive == nullptr || State.bHidden == Hidden)
+	{
+		return;
+	}
+
+	// Primitives which are already hidden in game are left alone so that they are never shown by culling.
+	if (Hidden && Primitive->bHiddenInGame)
+	{
+		return;
+	}
+
+	Primitive->SetHiddenInGame(Hidden);
+	State.bHidden = Hidden;
+}
+
+void UGTClippingCullingComponent::SetPrimitiveUnclipped(FGTClippingCullingState& State, bool Unclipped)
+{
+	UPrimitiveComponent* Primitive = State.Primitive.Get();
+
+	if (Primitive == nullptr || (State.ClippedMaterials.Num() != 0) == Unclipped)
+	{
+		return;
+	}
+
+	if (Unclipped)
+	{
+		const int32 NumMaterials = Primitive->GetNumMaterials();
+		bool Swapped = false;
+
+		for (int32 MaterialIndex = 0; MaterialIndex < NumMaterials; ++MaterialIndex)
+		{
+			UMaterialInterface* Material = Primitive->GetMaterial(MaterialIndex);
+			State.ClippedMaterials.Add(Material);
+
+			if (UMaterialInterface* const* UnclippedMaterial = UnclippedMaterials.Find(Material))
+			{
+				Primitive->SetMaterial(MaterialIndex, *UnclippedMaterial);
+				Swapped = true;
+			}
+		}
+
+		// Nothing to restore when none of the primitive's materials have a variant.
+		if (!Swapped)
+		{
+			State.ClippedMaterials.Reset();
+		}
+	}
+	else
+	{
+		for (int32 MaterialIndex = 0; MaterialIndex < State.ClippedMaterials.Num(); ++MaterialIndex)
+		{
+			if (Primitive->GetMaterial(MaterialIndex) != State.ClippedMaterials[MaterialIndex])
+			{
+				Primitive->SetMaterial(MaterialIndex, State.ClippedMaterials[MaterialIndex]);
+			}
+		}
+
+		State.ClippedMaterials.Reset();
+	}
+}
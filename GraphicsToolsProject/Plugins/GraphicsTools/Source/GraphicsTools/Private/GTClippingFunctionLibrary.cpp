@@ -0,0 +1,546 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "GTClippingFunctionLibrary.h"
+
+#include "GTClippingPrimitiveComponent.h"
+#include "GTSettings.h"
+#include "GTWorldSubsystem.h"
+
+#include "Async/ParallelFor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+namespace GTClippingFunctionLibrary
+{
+	using FPrimitiveArray = TArray<const UGTClippingPrimitiveComponent*, TInlineAllocator<16>>;
+
+	/** Points per ParallelFor task, a multiple of the SIMD width. */
+	constexpr int32 BatchSize = 4096;
+
+	/** Returns true if the world's materials read clipping primitives from the data texture. The subsystem decides this once when it is
+	 * initialized, so the project setting is not read directly. */
+	bool HasDataTexture(const UGTWorldSubsystem& Subsystem)
+	{
+		return Subsystem.GetDataTexture() != nullptr;
+	}
+
+	/**
+	 * Gathers the primitives of one type which materials evaluate. When the data texture is enabled every packed primitive is evaluated,
+	 * else only the primitive in the first slot is written to the WorldParameterCollection. Parameter collection materials do not support
+	 * clipping groups.
+	 */
+	void GatherPrimitives(
+		const UGTWorldSubsystem& Subsystem, const FGTComponentSlots& Slots, int32 ClippingGroupMask, FPrimitiveArray& OutPrimitives)
+	{
+		const UGTSettings* Settings = GetDefault<UGTSettings>();
+		OutPrimitives.Reset();
+
+		if (!HasDataTexture(Subsystem))
+		{
+			if (const UGTSceneComponent* Primitive = Slots[0])
+			{
+				OutPrimitives.Add(static_cast<const UGTClippingPrimitiveComponent*>(Primitive));
+			}
+
+			return;
+		}
+
+		int32 NumPacked = 0;
+
+		for (const UGTSceneComponent* Primitive : Slots.GetSlots())
+		{
+			if (Primitive == nullptr)
+			{
+				continue;
+			}
+
+			// Primitives outside of the mask are still packed, so they count towards the maximum.
+			if (NumPacked++ >= Settings->MaxDataTextureClippingPrimitives)
+			{
+				break;
+			}
+
+			const UGTClippingPrimitiveComponent* ClippingPrimitive = static_cast<const UGTClippingPrimitiveComponent*>(Primitive);
+
+			if ((ClippingPrimitive->GetClippingGroups() & ClippingGroupMask & GT_CLIPPING_GROUPS_ALL) != 0)
+			{
+				OutPrimitives.Add(ClippingPrimitive);
+			}
+		}
+	}
+
+	/** Returns true if primitives of the same type are combined by taking the maximum distance, rather than the minimum. */
+	bool IsIntersection(const UGTWorldSubsystem& Subsystem)
+	{
+		return HasDataTexture(Subsystem) &&
+			   GetDefault<UGTSettings>()->ClippingPrimitiveCombineMode == EGTClippingPrimitiveCombineMode::Intersection;
+	}
+
+	/** Combines a distance from each primitive of one type the same way materials do. */
+	template <typename DistanceFunc>
+	float CombinePrimitives(
+		const UGTWorldSubsystem& Subsystem, const FGTComponentSlots& Slots, int32 ClippingGroupMask, DistanceFunc Distance)
+	{
+		FPrimitiveArray Primitives;
+		GatherPrimitives(Subsystem, Slots, ClippingGroupMask, Primitives);
+
+		if (Primitives.Num() == 0)
+		{
+			return FLT_MAX;
+		}
+
+		const bool Intersection = IsIntersection(Subsystem);
+		float Result = Intersection ? -FLT_MAX : FLT_MAX;
+
+		for (const UGTClippingPrimitiveComponent* Primitive : Primitives)
+		{
+			const float PrimitiveDistance = Distance(Primitive);
+			Result = Intersection ? FMath::Max(Result, PrimitiveDistance) : FMath::Min(Result, PrimitiveDistance);
+		}
+
+		return Result;
+	}
+
+	/** Returns the world subsystem of a context object, or null. */
+	const UGTWorldSubsystem* FindWorldSubsystem(const UObject* WorldContextObject)
+	{
+		const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+		return World ? World->GetSubsystem<UGTWorldSubsystem>() : nullptr;
+	}
+
+	/** Returns the slots of every clipping primitive type within PrimitiveTypeMask, the remaining entries are null. */
+	void GatherTypes(const UGTWorldSubsystem& Subsystem, int32 PrimitiveTypeMask, const FGTComponentSlots* (&OutTypes)[4])
+	{
+		auto Select = [PrimitiveTypeMask](EGTClippingPrimitiveType Type) { return (PrimitiveTypeMask & static_cast<int32>(Type)) != 0; };
+
+		OutTypes[0] = Select(EGTClippingPrimitiveType::Plane) ? &Subsystem.ClippingPlanes : nullptr;
+		OutTypes[1] = Select(EGTClippingPrimitiveType::Sphere) ? &Subsystem.ClippingSpheres : nullptr;
+		OutTypes[2] = Select(EGTClippingPrimitiveType::Box) ? &Subsystem.ClippingBoxes : nullptr;
+		OutTypes[3] = Select(EGTClippingPrimitiveType::Cone) ? &Subsystem.ClippingCones : nullptr;
+	}
+
+	/** Takes the minimum distance of each clipping primitive type within a world and PrimitiveTypeMask. */
+	template <typename DistanceFunc>
+	float CombineWorld(const UObject* WorldContextObject, int32 ClippingGroupMask, int32 PrimitiveTypeMask, DistanceFunc Distance)
+	{
+		const UGTWorldSubsystem* Subsystem = FindWorldSubsystem(WorldContextObject);
+
+		if (Subsystem == nullptr)
+		{
+			return FLT_MAX;
+		}
+
+		const FGTComponentSlots* Types[4];
+		GatherTypes(*Subsystem, PrimitiveTypeMask, Types);
+		float Result = FLT_MAX;
+
+		for (const FGTComponentSlots* Type : Types)
+		{
+			if (Type != nullptr)
+			{
+				Result = FMath::Min(Result, CombinePrimitives(*Subsystem, *Type, ClippingGroupMask, Distance));
+			}
+		}
+
+		return Result;
+	}
+
+	/**
+	 * Evaluates a SIMD distance function over four points at a time, and a scalar distance function over any remaining points. Batches
+	 * are spread across worker threads.
+	 */
+	template <typename VectorFunc, typename ScalarFunc>
+	void EvaluateBatch(
+		TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, TArrayView<float> OutDistances,
+		VectorFunc VectorDistance, ScalarFunc ScalarDistance)
+	{
+		const int32 NumPoints = OutDistances.Num();
+		check(X.Num() == NumPoints && Y.Num() == NumPoints && Z.Num() == NumPoints);
+
+		const int32 NumBatches = FMath::DivideAndRoundUp(NumPoints, BatchSize);
+
+		ParallelFor(
+			NumBatches,
+			[&](int32 BatchIndex)
+			{
+				const int32 End = FMath::Min((BatchIndex + 1) * BatchSize, NumPoints);
+				int32 Index = BatchIndex * BatchSize;
+
+				for (; Index + 4 <= End; Index += 4)
+				{
+					VectorStore(VectorDistance(VectorLoad(&X[Index]), VectorLoad(&Y[Index]), VectorLoad(&Z[Index])), &OutDistances[Index]);
+				}
+
+				for (; Index < End; ++Index)
+				{
+					OutDistances[Index] = ScalarDistance(FVector(X[Index], Y[Index], Z[Index]));
+				}
+			},
+			NumBatches > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+	}
+
+	/** A matrix with each element splatted across a vector register, to transform four points at a time. */
+	struct FVectorMatrix
+	{
+		explicit FVectorMatrix(const FMatrix& Matrix)
+		{
+			for (int32 Row = 0; Row < 4; ++Row)
+			{
+				for (int32 Column = 0; Column < 3; ++Column)
+				{
+					M[Row][Column] = VectorSetFloat1(static_cast<float>(Matrix.M[Row][Column]));
+				}
+			}
+		}
+
+		/** Transforms four points, using Unreal's row vector convention. */
+		FORCEINLINE void TransformPositions(
+			const VectorRegister4Float& X, const VectorRegister4Float& Y, const VectorRegister4Float& Z, VectorRegister4Float& OutX,
+			VectorRegister4Float& OutY, VectorRegister4Float& OutZ) const
+		{
+			OutX = VectorMultiplyAdd(X, M[0][0], VectorMultiplyAdd(Y, M[1][0], VectorMultiplyAdd(Z, M[2][0], M[3][0])));
+			OutY = VectorMultiplyAdd(X, M[0][1], VectorMultiplyAdd(Y, M[1][1], VectorMultiplyAdd(Z, M[2][1], M[3][1])));
+			OutZ = VectorMultiplyAdd(X, M[0][2], VectorMultiplyAdd(Y, M[1][2], VectorMultiplyAdd(Z, M[2][2], M[3][2])));
+		}
+
+		VectorRegister4Float M[4][3];
+	};
+
+	/** Returns the length of four vectors. */
+	FORCEINLINE VectorRegister4Float Length(const VectorRegister4Float& X, const VectorRegister4Float& Y, const VectorRegister4Float& Z)
+	{
+		return VectorSqrt(VectorMultiplyAdd(X, X, VectorMultiplyAdd(Y, Y, VectorMultiply(Z, Z))));
+	}
+} // namespace GTClippingFunctionLibrary
+
+// Derived from distance functions provided from: https://www.iquilezles.org/www/articles/distfunctions/distfunctions.htm
+
+float UGTClippingFunctionLibrary::PointVsPlane(const FVector& Point, const FVector4& Plane, float ClippingSide)
+{
+	const FVector Normal(Plane);
+	const FVector PlanePosition = Normal * Plane.W;
+	return FVector::DotProduct(Point - PlanePosition, Normal) * ClippingSide;
+}
+
+float UGTClippingFunctionLibrary::PointVsSphere(const FVector& Point, const FMatrix& SphereInverseTransform, float ClippingSide)
+{
+	return (FVector(SphereInverseTransform.TransformPosition(Point)).Size() - 0.5) * ClippingSide;
+}
+
+float UGTClippingFunctionLibrary::PointVsBox(const FVector& Point, const FMatrix& BoxInverseTransform, float ClippingSide)
+{
+	const FVector Distance = FVector(BoxInverseTransform.TransformPosition(Point)).GetAbs() - FVector(0.5);
+	return (Distance.ComponentMax(FVector::ZeroVector).Size() + FMath::Min(Distance.GetMax(), 0.0)) * ClippingSide;
+}
+
+float UGTClippingFunctionLibrary::PointVsCone(const FVector& Point, const FVector4& ConeStart, const FVector4& ConeEnd, float ClippingSide)
+{
+	const FVector P = Point;
+	const FVector A(ConeStart);
+	const FVector B(ConeEnd);
+	const double RA = ConeStart.W;
+	const double RB = ConeEnd.W;
+
+	const double RBA = RB - RA;
+	const double BABA = FVector::DotProduct(B - A, B - A);
+	const double PAPA = FVector::DotProduct(P - A, P - A);
+	const double PABA = FVector::DotProduct(P - A, B - A) / BABA;
+
+	const double X = FMath::Sqrt(FMath::Max(PAPA - PABA * PABA * BABA, 0.0));
+
+	const double CAX = FMath::Max(0.0, X - ((PABA < 0.5) ? RA : RB));
+	const double CAY = FMath::Abs(PABA - 0.5) - 0.5;
+
+	const double K = RBA * RBA + BABA;
+	const double F = FMath::Clamp((RBA * (X - RA) + PABA * BABA) / K, 0.0, 1.0);
+
+	const double CBX = X - RA - F * RBA;
+	const double CBY = PABA - F;
+
+	const double S = (CBX < 0.0 && CAY < 0.0) ? -1.0 : 1.0;
+
+	return S * FMath::Sqrt(FMath::Min(CAX * CAX + CAY * CAY * BABA, CBX * CBX + CBY * CBY * BABA)) * ClippingSide;
+}
+
+float UGTClippingFunctionLibrary::GetClippingDistance(
+	const UObject* WorldContextObject, const FVector& Point, int32 ClippingGroupMask, int32 PrimitiveTypeMask)
+{
+	return GTClippingFunctionLibrary::CombineWorld(
+		WorldContextObject, ClippingGroupMask, PrimitiveTypeMask,
+		[&Point](const UGTClippingPrimitiveComponent* Primitive) { return Primitive->GetSignedDistance(Point); });
+}
+
+bool UGTClippingFunctionLibrary::IsPointClipped(
+	const UObject* WorldContextObject, const FVector& Point, int32 ClippingGroupMask, int32 PrimitiveTypeMask)
+{
+	return GetClippingDistance(WorldContextObject, Point, ClippingGroupMask, PrimitiveTypeMask) < 0;
+}
+
+bool UGTClippingFunctionLibrary::IsBoundsClipped(
+	const UObject* WorldContextObject, const FBoxSphereBounds& Bounds, int32 ClippingGroupMask, int32 PrimitiveTypeMask)
+{
+	// Taking the minimum (or maximum) of each primitive's upper bound is an upper bound of the combined distance of every point.
+	return GTClippingFunctionLibrary::CombineWorld(
+			   WorldContextObject, ClippingGroupMask, PrimitiveTypeMask,
+			   [&Bounds](const UGTClippingPrimitiveComponent* Primitive) { return Primitive->GetMaxSignedDistance(Bounds); }) < 0;
+}
+
+bool UGTClippingFunctionLibrary::IsBoundsUnclipped(
+	const UObject* WorldContextObject, const FBoxSphereBounds& Bounds, int32 ClippingGroupMask, int32 PrimitiveTypeMask)
+{
+	// Likewise the minimum (or maximum) of each primitive's lower bound is a lower bound of the combined distance of every point.
+	return GTClippingFunctionLibrary::CombineWorld(
+			   WorldContextObject, ClippingGroupMask, PrimitiveTypeMask,
+			   [&Bounds](const UGTClippingPrimitiveComponent* Primitive) { return Primitive->GetMinSignedDistance(Bounds); }) >= 0;
+}
+
+void UGTClippingFunctionLibrary::SetClippingGroupMask(UPrimitiveComponent* Primitive, int32 DataIndex, int32 ClippingGroupMask)
+{
+	if (Primitive != nullptr)
+	{
+		Primitive->SetCustomPrimitiveDataFloat(DataIndex, static_cast<float>(ClippingGroupMask & GT_CLIPPING_GROUPS_ALL));
+	}
+}
+
+bool UGTClippingFunctionLibrary::SetInstanceClippingGroupMask(
+	UInstancedStaticMeshComponent* Instances, int32 InstanceIndex, int32 DataIndex, int32 ClippingGroupMask, bool MarkRenderStateDirty)
+{
+	if (Instances == nullptr)
+	{
+		return false;
+	}
+
+	return Instances->SetCustomDataValue(
+		InstanceIndex, DataIndex, static_cast<float>(ClippingGroupMask & GT_CLIPPING_GROUPS_ALL), MarkRenderStateDirty);
+}
+
+bool UGTClippingFunctionLibrary::SetInstanceClippingPlane(
+	UInstancedStaticMeshComponent* Instances, int32 InstanceIndex, int32 DataIndex, const FVector4& Plane, bool MarkRenderStateDirty)
+{
+	if (Instances == nullptr || DataIndex < 0 || DataIndex + GT_CLIPPING_INSTANCE_DATA_FLOATS > Instances->NumCustomDataFloats)
+	{
+		return false;
+	}
+
+	// Only the last write needs to dirty the render state.
+	return Instances->SetCustomDataValue(InstanceIndex, DataIndex + 1, Plane.X, false) &&
+		   Instances->SetCustomDataValue(InstanceIndex, DataIndex + 2, Plane.Y, false) &&
+		   Instances->SetCustomDataValue(InstanceIndex, DataIndex + 3, Plane.Z, false) &&
+		   Instances->SetCustomDataValue(InstanceIndex, DataIndex + 4, Plane.W, MarkRenderStateDirty);
+}
+
+float UGTClippingFunctionLibrary::GetInstanceClippingDistance(
+	const UInstancedStaticMeshComponent* Instances, int32 InstanceIndex, int32 DataIndex, const FVector& Point)
+{
+	if (Instances == nullptr || !Instances->IsValidInstance(InstanceIndex) || DataIndex < 0 ||
+		DataIndex + GT_CLIPPING_INSTANCE_DATA_FLOATS > Instances->NumCustomDataFloats)
+	{
+		return FLT_MAX;
+	}
+
+	const float* Data = &Instances->PerInstanceSMCustomData[(InstanceIndex * Instances->NumCustomDataFloats) + DataIndex];
+	const FVector4 Plane(Data[1], Data[2], Data[3], Data[4]);
+	const int32 ClippingGroupMask = static_cast<int32>(Data[0]);
+
+	// GTClippingInstanceData only reads the world's clipping primitives from the data texture, without it only the plane clips.
+	const UGTWorldSubsystem* Subsystem = GTClippingFunctionLibrary::FindWorldSubsystem(Instances);
+	const bool UsesDataTexture = Subsystem != nullptr && GTClippingFunctionLibrary::HasDataTexture(*Subsystem);
+	const float Distance =
+		(ClippingGroupMask != 0 && UsesDataTexture) ? GetClippingDistance(Instances, Point, ClippingGroupMask) : FLT_MAX;
+
+	// A zero plane is disabled, matching GTClippingInstancePlane.
+	return FVector(Plane).IsZero() ? Distance : FMath::Min(Distance, PointVsPlane(Point, Plane, 1));
+}
+
+void UGTClippingFunctionLibrary::PointsVsPlane(
+	TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, const FVector4& Plane, float ClippingSide,
+	TArrayView<float> OutDistances)
+{
+	// dot(p - n * w, n) * side == (dot(p, n) - w * dot(n, n)) * side
+	const FVector Normal(Plane);
+	const VectorRegister4Float NX = VectorSetFloat1(Normal.X * ClippingSide);
+	const VectorRegister4Float NY = VectorSetFloat1(Normal.Y * ClippingSide);
+	const VectorRegister4Float NZ = VectorSetFloat1(Normal.Z * ClippingSide);
+	const VectorRegister4Float Offset = VectorSetFloat1(Plane.W * Normal.SizeSquared() * ClippingSide);
+
+	GTClippingFunctionLibrary::EvaluateBatch(
+		X, Y, Z, OutDistances,
+		[&](const VectorRegister4Float& PX, const VectorRegister4Float& PY, const VectorRegister4Float& PZ)
+		{ return VectorSubtract(VectorMultiplyAdd(PX, NX, VectorMultiplyAdd(PY, NY, VectorMultiply(PZ, NZ))), Offset); },
+		[&](const FVector& Point) { return PointVsPlane(Point, Plane, ClippingSide); });
+}
+
+void UGTClippingFunctionLibrary::PointsVsSphere(
+	TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, const FMatrix& SphereInverseTransform,
+	float ClippingSide, TArrayView<float> OutDistances)
+{
+	const GTClippingFunctionLibrary::FVectorMatrix Matrix(SphereInverseTransform);
+	const VectorRegister4Float Radius = VectorSetFloat1(0.5f);
+	const VectorRegister4Float Side = VectorSetFloat1(ClippingSide);
+
+	GTClippingFunctionLibrary::EvaluateBatch(
+		X, Y, Z, OutDistances,
+		[&](const VectorRegister4Float& PX, const VectorRegister4Float& PY, const VectorRegister4Float& PZ)
+		{
+			VectorRegister4Float LX, LY, LZ;
+			Matrix.TransformPositions(PX, PY, PZ, LX, LY, LZ);
+			return VectorMultiply(VectorSubtract(GTClippingFunctionLibrary::Length(LX, LY, LZ), Radius), Side);
+		},
+		[&](const FVector& Point) { return PointVsSphere(Point, SphereInverseTransform, ClippingSide); });
+}
+
+void UGTClippingFunctionLibrary::PointsVsBox(
+	TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, const FMatrix& BoxInverseTransform,
+	float ClippingSide, TArrayView<float> OutDistances)
+{
+	const GTClippingFunctionLibrary::FVectorMatrix Matrix(BoxInverseTransform);
+	const VectorRegister4Float HalfSize = VectorSetFloat1(0.5f);
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float Side = VectorSetFloat1(ClippingSide);
+
+	GTClippingFunctionLibrary::EvaluateBatch(
+		X, Y, Z, OutDistances,
+		[&](const VectorRegister4Float& PX, const VectorRegister4Float& PY, const VectorRegister4Float& PZ)
+		{
+			VectorRegister4Float LX, LY, LZ;
+			Matrix.TransformPositions(PX, PY, PZ, LX, LY, LZ);
+
+			const VectorRegister4Float DX = VectorSubtract(VectorAbs(LX), HalfSize);
+			const VectorRegister4Float DY = VectorSubtract(VectorAbs(LY), HalfSize);
+			const VectorRegister4Float DZ = VectorSubtract(VectorAbs(LZ), HalfSize);
+
+			const VectorRegister4Float Outside =
+				GTClippingFunctionLibrary::Length(VectorMax(DX, Zero), VectorMax(DY, Zero), VectorMax(DZ, Zero));
+			const VectorRegister4Float Inside = VectorMin(VectorMax(DX, VectorMax(DY, DZ)), Zero);
+
+			return VectorMultiply(VectorAdd(Outside, Inside), Side);
+		},
+		[&](const FVector& Point) { return PointVsBox(Point, BoxInverseTransform, ClippingSide); });
+}
+
+void UGTClippingFunctionLibrary::PointsVsCone(
+	TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, const FVector4& ConeStart, const FVector4& ConeEnd,
+	float ClippingSide, TArrayView<float> OutDistances)
+{
+	const FVector3f A(FVector(ConeStart));
+	const FVector3f BA = FVector3f(FVector(ConeEnd)) - A;
+	const float RA = ConeStart.W;
+	const float RB = ConeEnd.W;
+	const float RBAScalar = RB - RA;
+	const float BABAScalar = BA.SizeSquared();
+
+	const VectorRegister4Float AX = VectorSetFloat1(A.X);
+	const VectorRegister4Float AY = VectorSetFloat1(A.Y);
+	const VectorRegister4Float AZ = VectorSetFloat1(A.Z);
+	const VectorRegister4Float BAX = VectorSetFloat1(BA.X);
+	const VectorRegister4Float BAY = VectorSetFloat1(BA.Y);
+	const VectorRegister4Float BAZ = VectorSetFloat1(BA.Z);
+	const VectorRegister4Float VectorRA = VectorSetFloat1(RA);
+	const VectorRegister4Float VectorRB = VectorSetFloat1(RB);
+	const VectorRegister4Float RBA = VectorSetFloat1(RBAScalar);
+	const VectorRegister4Float BABA = VectorSetFloat1(BABAScalar);
+	const VectorRegister4Float InvBABA = VectorSetFloat1(1.0f / BABAScalar);
+	const VectorRegister4Float InvK = VectorSetFloat1(1.0f / (RBAScalar * RBAScalar + BABAScalar));
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+	const VectorRegister4Float One = VectorOneFloat();
+	const VectorRegister4Float Side = VectorSetFloat1(ClippingSide);
+	const VectorRegister4Float NegativeSide = VectorSetFloat1(-ClippingSide);
+
+	GTClippingFunctionLibrary::EvaluateBatch(
+		X, Y, Z, OutDistances,
+		[&](const VectorRegister4Float& PX, const VectorRegister4Float& PY, const VectorRegister4Float& PZ)
+		{
+			const VectorRegister4Float PAX = VectorSubtract(PX, AX);
+			const VectorRegister4Float PAY = VectorSubtract(PY, AY);
+			const VectorRegister4Float PAZ = VectorSubtract(PZ, AZ);
+
+			const VectorRegister4Float PAPA = VectorMultiplyAdd(PAX, PAX, VectorMultiplyAdd(PAY, PAY, VectorMultiply(PAZ, PAZ)));
+			const VectorRegister4Float PABA =
+				VectorMultiply(VectorMultiplyAdd(PAX, BAX, VectorMultiplyAdd(PAY, BAY, VectorMultiply(PAZ, BAZ))), InvBABA);
+
+			const VectorRegister4Float Radial =
+				VectorSqrt(VectorMax(VectorSubtract(PAPA, VectorMultiply(VectorMultiply(PABA, PABA), BABA)), Zero));
+
+			const VectorRegister4Float CAX =
+				VectorMax(Zero, VectorSubtract(Radial, VectorSelect(VectorCompareLT(PABA, Half), VectorRA, VectorRB)));
+			const VectorRegister4Float CAY = VectorSubtract(VectorAbs(VectorSubtract(PABA, Half)), Half);
+
+			const VectorRegister4Float Slope =
+				VectorMultiply(VectorMultiplyAdd(RBA, VectorSubtract(Radial, VectorRA), VectorMultiply(PABA, BABA)), InvK);
+			const VectorRegister4Float F = VectorMin(VectorMax(Slope, Zero), One);
+
+			const VectorRegister4Float CBX = VectorSubtract(VectorSubtract(Radial, VectorRA), VectorMultiply(F, RBA));
+			const VectorRegister4Float CBY = VectorSubtract(PABA, F);
+
+			const VectorRegister4Float DistanceA = VectorMultiplyAdd(CAX, CAX, VectorMultiply(VectorMultiply(CAY, CAY), BABA));
+			const VectorRegister4Float DistanceB = VectorMultiplyAdd(CBX, CBX, VectorMultiply(VectorMultiply(CBY, CBY), BABA));
+			const VectorRegister4Float Inside = VectorBitwiseAnd(VectorCompareLT(CBX, Zero), VectorCompareLT(CAY, Zero));
+
+			return VectorMultiply(VectorSqrt(VectorMin(DistanceA, DistanceB)), VectorSelect(Inside, NegativeSide, Side));
+		},
+		[&](const FVector& Point) { return PointVsCone(Point, ConeStart, ConeEnd, ClippingSide); });
+}
+
+void UGTClippingFunctionLibrary::GetClippingDistances(
+	const UObject* WorldContextObject, TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z,
+	TArrayView<float> OutDistances, int32 ClippingGroupMask, int32 PrimitiveTypeMask)
+{
+	for (float& Distance : OutDistances)
+	{
+		Distance = FLT_MAX;
+	}
+
+	const UGTWorldSubsystem* Subsystem = GTClippingFunctionLibrary::FindWorldSubsystem(WorldContextObject);
+
+	if (Subsystem == nullptr)
+	{
+		return;
+	}
+
+	const bool Intersection = GTClippingFunctionLibrary::IsIntersection(*Subsystem);
+	const FGTComponentSlots* Types[4];
+	GTClippingFunctionLibrary::GatherTypes(*Subsystem, PrimitiveTypeMask, Types);
+	GTClippingFunctionLibrary::FPrimitiveArray Primitives;
+	TArray<float> TypeDistances;
+	TArray<float> PrimitiveDistances;
+
+	for (const FGTComponentSlots* Type : Types)
+	{
+		if (Type == nullptr)
+		{
+			continue;
+		}
+
+		GTClippingFunctionLibrary::GatherPrimitives(*Subsystem, *Type, ClippingGroupMask, Primitives);
+
+		if (Primitives.Num() == 0)
+		{
+			continue;
+		}
+
+		// Combine each primitive within the type, then take the minimum of each type.
+		TypeDistances.SetNumUninitialized(OutDistances.Num(), false);
+		Primitives[0]->GetSignedDistances(X, Y, Z, TypeDistances);
+
+		for (int32 PrimitiveIndex = 1; PrimitiveIndex < Primitives.Num(); ++PrimitiveIndex)
+		{
+			PrimitiveDistances.SetNumUninitialized(OutDistances.Num(), false);
+			Primitives[PrimitiveIndex]->GetSignedDistances(X, Y, Z, PrimitiveDistances);
+
+			for (int32 Index = 0; Index < TypeDistances.Num(); ++Index)
+			{
+				TypeDistances[Index] = Intersection ? FMath::Max(TypeDistances[Index], PrimitiveDistances[Index])
+													: FMath::Min(TypeDistances[Index], PrimitiveDistances[Index]);
+			}
+		}
+
+		for (int32 Index = 0; Index < TypeDistances.Num(); ++Index)
+		{
+			OutDistances[Index] = FMath::Min(OutDistances[Index], TypeDistances[Index]);
+		}
+	}
+}
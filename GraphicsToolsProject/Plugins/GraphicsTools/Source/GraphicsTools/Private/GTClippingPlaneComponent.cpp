@@ -3,6 +3,7 @@
 
 #include "GTClippingPlaneComponent.h"
 
+#include "GTClippingFunctionLibrary.h"
 #include "GTWorldSubsystem.h"
 
 UGTClippingPlaneComponent::UGTClippingPlaneComponent()
@@ -19,17 +20,44 @@ UGTClippingPlaneComponent::UGTClippingPlaneComponent()
 	}
 }
 
-TArray<UGTSceneComponent*>& UGTClippingPlaneComponent::GetWorldComponents()
+FGTComponentSlots& UGTClippingPlaneComponent::GetWorldComponents()
 {
-	return GetWorld()->GetSubsystem<UGTWorldSubsystem>()->ClippingPlanes;
+	return GetWorldSubsystem()->ClippingPlanes;
 }
 
-void UGTClippingPlaneComponent::UpdateParameterCollectionTransform()
+void UGTClippingPlaneComponent::CalculateTransformColumns(FLinearColor* Columns) const
 {
 	const FTransform& Tranform = GetComponentTransform();
 	FVector Normal = Tranform.GetUnitAxis(EAxis::X);
 
-	SetVectorParameterValue(
-		GetTransformColumnParameterNames()[0],
-		FLinearColor(Normal.X, Normal.Y, Normal.Z, FVector::DotProduct(Normal, Tranform.GetLocation())));
+	Columns[0] = FLinearColor(Normal.X, Normal.Y, Normal.Z, FVector::DotProduct(Normal, Tranform.GetLocation()));
+}
+
+float UGTClippingPlaneComponent::CalculateSignedDistance(const FVector& Point) const
+{
+	const FLinearColor& Plane = GetTransformColumns()[0];
+
+	return UGTClippingFunctionLibrary::PointVsPlane(Point, FVector4(Plane), GetClippingSideSign());
+}
+
+float UGTClippingPlaneComponent::CalculateMaxSignedDistance(const FBoxSphereBounds& Bounds) const
+{
+	const FVector Normal = GetComponentTransform().GetUnitAxis(EAxis::X);
+
+	return CalculateSignedDistance(Bounds.Origin) + FVector::DotProduct(Normal.GetAbs(), Bounds.BoxExtent);
+}
+
+float UGTClippingPlaneComponent::CalculateMinSignedDistance(const FBoxSphereBounds& Bounds) const
+{
+	const FVector Normal = GetComponentTransform().GetUnitAxis(EAxis::X);
+
+	return CalculateSignedDistance(Bounds.Origin) - FVector::DotProduct(Normal.GetAbs(), Bounds.BoxExtent);
+}
+
+void UGTClippingPlaneComponent::CalculateSignedDistances(
+	TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, TArrayView<float> OutDistances) const
+{
+	const FLinearColor& Plane = GetTransformColumns()[0];
+
+	UGTClippingFunctionLibrary::PointsVsPlane(X, Y, Z, FVector4(Plane), GetClippingSideSign(), OutDistances);
 }
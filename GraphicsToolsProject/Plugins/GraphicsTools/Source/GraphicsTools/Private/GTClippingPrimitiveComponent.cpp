@@ -3,6 +3,7 @@
 
 #include "GTClippingPrimitiveComponent.h"
 
+#include "GTWorldSubsystem.h"
 #include "GraphicsTools.h"
 
 #include "UObject/ConstructorHelpers.h"
@@ -30,7 +31,18 @@ void UGTClippingPrimitiveComponent::SetClippingSide(EGTClippingSide Side)
 	if (ClippingSide != Side)
 	{
 		ClippingSide = Side;
-		UpdateParameterCollection();
+		MarkParameterCollectionDirty();
+	}
+}
+
+void UGTClippingPrimitiveComponent::SetClippingGroups(int32 Groups)
+{
+	Groups &= GT_CLIPPING_GROUPS_ALL;
+
+	if (ClippingGroups != Groups)
+	{
+		ClippingGroups = Groups;
+		MarkParameterCollectionDirty();
 	}
 }
 
@@ -39,26 +51,34 @@ void UGTClippingPrimitiveComponent::SetSettingsParameterName(const FName& Name)
 	if (SettingsParameterName != Name)
 	{
 		SettingsParameterName = Name;
-		UpdateParameterCollection();
+		SettingsParameterIndex = FindParameterIndex(SettingsParameterName);
+		MarkParameterCollectionDirty();
 	}
 }
 
 void UGTClippingPrimitiveComponent::SetTransformColumnParameterNames(const TArray<FName>& Names)
 {
-	if (Names.Num() >= GetTransformColumnCount())
+	if (Names.Num() >= GetRequiredTransformColumnCount())
 	{
 		TransformColumnParameterNames = Names;
-		UpdateParameterCollection();
+		FindParameterIndices(TransformColumnParameterNames, TransformColumnParameterIndices);
+		MarkParameterCollectionDirty();
 	}
 	else
 	{
 		UE_LOG(
 			GraphicsTools, Warning,
 			TEXT("Unable to SetTransformColumnParameterNames because the input does not contain at least %i column names."),
-			GetTransformColumnCount());
+			GetRequiredTransformColumnCount());
 	}
 }
 
+void UGTClippingPrimitiveComponent::PackPrimitiveData(FLinearColor* Data, bool IsDisabled) const
+{
+	Data[0] = CalculateSettings(IsDisabled);
+	FMemory::Memcpy(Data + 1, GetTransformColumns(), GetTransformColumnCount() * sizeof(FLinearColor));
+}
+
 #if WITH_EDITOR
 bool UGTClippingPrimitiveComponent::CanEditChange(const FProperty* Property) const
 {
@@ -91,35 +111,156 @@ void UGTClippingPrimitiveComponent::PostEditChangeProperty(FPropertyChangedEvent
 }
 #endif // WITH_EDITOR
 
+void UGTClippingPrimitiveComponent::CacheParameterIndices()
+{
+	SettingsParameterIndex = FindParameterIndex(SettingsParameterName);
+	FindParameterIndices(TransformColumnParameterNames, TransformColumnParameterIndices);
+
+	// The parameter collection changed, so the transform must be written again.
+	bTransformUploaded = false;
+}
+
 void UGTClippingPrimitiveComponent::UpdateParameterCollection(bool IsDisabled)
 {
+	GT_SCOPE_CYCLE_COUNTER(STAT_GTUpdateClippingPrimitive);
+
 	if (IsValid())
 	{
-		const TArray<UGTSceneComponent*>& Components = GetWorldComponents();
-		const int32 ComponentIndex = Components.Find(this);
-
-		// Only the first clipping primitive of this type will be considered, or a disabled clipping primitive of this type in the case of
-		// removing the last clipping primitive of this type, or any components with an MPC override.
-		if (ComponentIndex == 0 || IsDisabled || HasParameterCollectionOverride())
+		if (!HasParameterCollectionOverride())
 		{
-			const float Side = GetClippingSide() == EGTClippingSide::Inside ? 1 : -1;
-			SetVectorParameterValue(GetSettingsParameterName(), FLinearColor(!IsDisabled, Side, 0));
+			// Every world clipping primitive is written to the data texture, not just the first of each type.
+			GetWorldSubsystem()->MarkDataTextureDirty();
+		}
 
-			UpdateParameterCollectionTransform();
+		if (IsWritingParameterCollection())
+		{
+			SetVectorParameterValue(SettingsParameterIndex, CalculateSettings(IsDisabled));
+			SetTransformColumnParameterValues();
 		}
+
+		UploadedTransform = GetComponentTransform();
+		bTransformUploaded = true;
 	}
 }
 
 void UGTClippingPrimitiveComponent::UpdateParameterCollectionTransform()
+{
+	GT_SCOPE_CYCLE_COUNTER(STAT_GTUpdateClippingPrimitive);
+
+	if (IsValid())
+	{
+		// Transform updates are also raised when a parent is re-attached or updated without moving this primitive, the columns already
+		// sent to materials remain correct.
+		if (bTransformUploaded && GetComponentTransform().Equals(UploadedTransform, 0))
+		{
+			GetWorldSubsystem()->AddSkippedTransformUpdate();
+			return;
+		}
+
+		if (!HasParameterCollectionOverride())
+		{
+			GetWorldSubsystem()->MarkDataTextureDirty();
+		}
+
+		if (IsWritingParameterCollection())
+		{
+			SetTransformColumnParameterValues();
+		}
+
+		UploadedTransform = GetComponentTransform();
+		bTransformUploaded = true;
+	}
+}
+
+bool UGTClippingPrimitiveComponent::IsWritingParameterCollection() const
+{
+	// Only the clipping primitive in the first slot of this type will be considered, or any components with an MPC override. The slot
+	// allocator moves another clipping primitive of this type into the first slot when it is freed.
+	return GetWorldSlotIndex() == 0 || HasParameterCollectionOverride();
+}
+
+void UGTClippingPrimitiveComponent::SetTransformColumnParameterValues()
+{
+	const FLinearColor* Columns = GetTransformColumns();
+	const TArray<int32>& ParameterIndices = GetTransformColumnParameterIndices();
+	const int32 NumColumns = FMath::Min(GetTransformColumnCount(), ParameterIndices.Num());
+
+	for (int32 ColumnIndex = 0; ColumnIndex < NumColumns; ++ColumnIndex)
+	{
+		SetVectorParameterValue(ParameterIndices[ColumnIndex], Columns[ColumnIndex]);
+	}
+}
+
+const FLinearColor* UGTClippingPrimitiveComponent::GetTransformColumns() const
+{
+	const FTransform& Transform = GetComponentTransform();
+
+	if (!bTransformColumnsCached || !Transform.Equals(CachedColumnsTransform, 0))
+	{
+		check(GetTransformColumnCount() <= UE_ARRAY_COUNT(CachedTransformColumns));
+		CalculateTransformColumns(CachedTransformColumns);
+		CachedColumnsTransform = Transform;
+		bTransformColumnsCached = true;
+	}
+
+	return CachedTransformColumns;
+}
+
+FLinearColor UGTClippingPrimitiveComponent::CalculateSettings(bool IsDisabled) const
+{
+	return FLinearColor(!IsDisabled, GetClippingSideSign(), ClippingGroups & GT_CLIPPING_GROUPS_ALL);
+}
+
+void UGTClippingPrimitiveComponent::CalculateSignedDistances(
+	TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, TArrayView<float> OutDistances) const
+{
+	for (int32 Index = 0; Index < OutDistances.Num(); ++Index)
+	{
+		OutDistances[Index] = CalculateSignedDistance(FVector(X[Index], Y[Index], Z[Index]));
+	}
+}
+
+float UGTClippingPrimitiveComponent::CalculateMaxSignedDistance(const FBoxSphereBounds& Bounds) const
+{
+	return CalculateSignedDistance(Bounds.Origin) + (Bounds.SphereRadius * GetDistanceScale());
+}
+
+float UGTClippingPrimitiveComponent::CalculateMinSignedDistance(const FBoxSphereBounds& Bounds) const
+{
+	return CalculateSignedDistance(Bounds.Origin) - (Bounds.SphereRadius * GetDistanceScale());
+}
+
+FMatrix UGTClippingPrimitiveComponent::CalculateInverseTransform() const
 {
 	FTransform Tranform = GetComponentTransform();
 	Tranform.SetScale3D(Tranform.GetScale3D() * 2); // Double the scale to ensure sizing is consistent with other Unreal primitives.
-	FMatrix InverseMatrixTranspose = Tranform.ToInverseMatrixWithScale().GetTransposed();
-	const TArray<FName>& ParameterNames = GetTransformColumnParameterNames();
+	return Tranform.ToInverseMatrixWithScale();
+}
+
+FMatrix UGTClippingPrimitiveComponent::GetCachedInverseTransform() const
+{
+	// The default columns are the first three components of each row of the inverse transform, the last component of each row is implied
+	// by the matrix being affine.
+	const FLinearColor* Columns = GetTransformColumns();
+	return FMatrix(
+		FPlane(Columns[0].R, Columns[0].G, Columns[0].B, 0), FPlane(Columns[1].R, Columns[1].G, Columns[1].B, 0),
+		FPlane(Columns[2].R, Columns[2].G, Columns[2].B, 0), FPlane(Columns[3].R, Columns[3].G, Columns[3].B, 1));
+}
+
+float UGTClippingPrimitiveComponent::CalculateInverseTransformDistanceScale() const
+{
+	// A unit step in world space is at most a step of one over the smallest (doubled) scale in local space.
+	const float MinScale = GetComponentTransform().GetScale3D().GetAbs().GetMin() * 2;
+	return MinScale > UE_SMALL_NUMBER ? 1 / MinScale : FLT_MAX;
+}
+
+void UGTClippingPrimitiveComponent::CalculateTransformColumns(FLinearColor* Columns) const
+{
+	FMatrix InverseMatrixTranspose = CalculateInverseTransform().GetTransposed();
 
 	for (int32 ColumnIndex = 0; ColumnIndex < GetTransformColumnCount(); ++ColumnIndex)
 	{
 		FVector3d Column = InverseMatrixTranspose.GetColumn(ColumnIndex);
-		SetVectorParameterValue(ParameterNames[ColumnIndex], FLinearColor(Column.X, Column.Y, Column.Z));
+		Columns[ColumnIndex] = FLinearColor(Column.X, Column.Y, Column.Z);
 	}
 }
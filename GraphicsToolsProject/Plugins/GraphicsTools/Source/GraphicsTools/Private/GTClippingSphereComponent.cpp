@@ -3,6 +3,7 @@
 
 #include "GTClippingSphereComponent.h"
 
+#include "GTClippingFunctionLibrary.h"
 #include "GTWorldSubsystem.h"
 
 #include "Engine/World.h"
@@ -23,7 +24,18 @@ UGTClippingSphereComponent::UGTClippingSphereComponent()
 	}
 }
 
-TArray<UGTSceneComponent*>& UGTClippingSphereComponent::GetWorldComponents()
+FGTComponentSlots& UGTClippingSphereComponent::GetWorldComponents()
 {
-	return GetWorld()->GetSubsystem<UGTWorldSubsystem>()->ClippingSpheres;
+	return GetWorldSubsystem()->ClippingSpheres;
+}
+
+float UGTClippingSphereComponent::CalculateSignedDistance(const FVector& Point) const
+{
+	return UGTClippingFunctionLibrary::PointVsSphere(Point, GetCachedInverseTransform(), GetClippingSideSign());
+}
+
+void UGTClippingSphereComponent::CalculateSignedDistances(
+	TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, TArrayView<float> OutDistances) const
+{
+	UGTClippingFunctionLibrary::PointsVsSphere(X, Y, Z, GetCachedInverseTransform(), GetClippingSideSign(), OutDistances);
 }
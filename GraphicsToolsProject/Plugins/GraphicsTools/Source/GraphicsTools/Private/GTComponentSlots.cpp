@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "GTComponentSlots.h"
+
+int32 FGTComponentSlots::Add(UGTSceneComponent* Component)
+{
+	++Count;
+
+	if (FreeHead != INDEX_NONE)
+	{
+		const int32 SlotIndex = FreeHead;
+		UnlinkFreeSlot(SlotIndex);
+		Slots[SlotIndex] = Component;
+
+		return SlotIndex;
+	}
+
+	FreeNext.Add(INDEX_NONE);
+	FreePrev.Add(INDEX_NONE);
+
+	return Slots.Add(Component);
+}
+
+UGTSceneComponent* FGTComponentSlots::Remove(int32 SlotIndex, int32 NumActiveSlots)
+{
+	check(Slots.IsValidIndex(SlotIndex) && Slots[SlotIndex] != nullptr);
+
+	Slots[SlotIndex] = nullptr;
+	--Count;
+
+	PushFreeSlot(SlotIndex);
+	TrimFreeSlots();
+
+	if (SlotIndex < NumActiveSlots && Slots.Num() > NumActiveSlots)
+	{
+		// Keep the active slots filled by moving the component from the highest slot, which is occupied after trimming.
+		UGTSceneComponent* MovedComponent = Slots.Pop(false);
+		FreeNext.Pop(false);
+		FreePrev.Pop(false);
+
+		UnlinkFreeSlot(SlotIndex);
+		Slots[SlotIndex] = MovedComponent;
+		TrimFreeSlots();
+
+		return MovedComponent;
+	}
+
+	return nullptr;
+}
+
+void FGTComponentSlots::PushFreeSlot(int32 SlotIndex)
+{
+	FreePrev[SlotIndex] = INDEX_NONE;
+	FreeNext[SlotIndex] = FreeHead;
+
+	if (FreeHead != INDEX_NONE)
+	{
+		FreePrev[FreeHead] = SlotIndex;
+	}
+
+	FreeHead = SlotIndex;
+}
+
+void FGTComponentSlots::UnlinkFreeSlot(int32 SlotIndex)
+{
+	const int32 Prev = FreePrev[SlotIndex];
+	const int32 Next = FreeNext[SlotIndex];
+
+	if (Prev != INDEX_NONE)
+	{
+		FreeNext[Prev] = Next;
+	}
+	else
+	{
+		FreeHead = Next;
+	}
+
+	if (Next != INDEX_NONE)
+	{
+		FreePrev[Next] = Prev;
+	}
+}
+
+void FGTComponentSlots::TrimFreeSlots()
+{
+	while (Slots.Num() != 0 && Slots.Last() == nullptr)
+	{
+		UnlinkFreeSlot(Slots.Num() - 1);
+		Slots.Pop(false);
+		FreeNext.Pop(false);
+		FreePrev.Pop(false);
+	}
+}
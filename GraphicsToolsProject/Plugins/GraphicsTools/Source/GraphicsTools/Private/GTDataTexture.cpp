@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "GTDataTexture.h"
+
+#include "Engine/Texture2D.h"
+#include "RenderingThread.h"
+
+void FGTDataTexture::Reset(int32 NumTexels)
+{
+	const int32 Height = FMath::Max(FMath::DivideAndRoundUp(NumTexels, GT_DATA_TEXTURE_WIDTH), 1);
+
+	Texels.Reset();
+	Texels.SetNumZeroed(Height * GT_DATA_TEXTURE_WIDTH);
+	LocationPredictions.Reset();
+
+	if (Texture == nullptr || Texture->GetSizeY() != Height)
+	{
+		Texture = UTexture2D::CreateTransient(GT_DATA_TEXTURE_WIDTH, Height, PF_A32B32G32R32F, TEXT("GTDataTexture"));
+		Texture->Filter = TF_Nearest;
+		Texture->SRGB = false;
+		Texture->NeverStream = true;
+		Texture->UpdateResource();
+	}
+}
+
+void FGTDataTexture::AddLocationPrediction(
+	int32 TexelIndex, const FVector& Location, const FVector& Velocity, double SampleTime, float PredictionTime)
+{
+	LocationPredictions.Add({TexelIndex, FVector3f(Location), FVector3f(Velocity), SampleTime, PredictionTime});
+}
+
+void FGTDataTexture::Submit()
+{
+	if (!bPendingUpload || Texture == nullptr || Texture->GetResource() == nullptr)
+	{
+		return;
+	}
+
+	bPendingUpload = false;
+
+	// The render thread owns a snapshot of the texels, so the game thread is free to repack the texels next frame.
+	ENQUEUE_RENDER_COMMAND(GTUpdateDataTexture)
+	(
+		[Resource = Texture->GetResource(), Data = TArray<FLinearColor>(Texels),
+		 Predictions = TArray<FLocationPrediction>(LocationPredictions)](FRHICommandListImmediate& RHICmdList) mutable
+		{
+			if (Resource->TextureRHI.IsValid())
+			{
+				// The render thread can trail the game thread by a frame, so extrapolate the locations from when they were sampled to when
+				// this frame is rendered. Limit the extrapolation so that a hitch does not throw the light far from the joint.
+				const double Time = FPlatformTime::Seconds();
+
+				for (const FLocationPrediction& Prediction : Predictions)
+				{
+					const float Elapsed =
+						FMath::Min(static_cast<float>(Time - Prediction.SampleTime) + Prediction.PredictionTime, MaxPredictionTime);
+					const FVector3f Location = Prediction.Location + (Prediction.Velocity * Elapsed);
+					FLinearColor& Texel = Data[Prediction.TexelIndex];
+					Texel = FLinearColor(Location.X, Location.Y, Location.Z, Texel.A);
+				}
+
+				const FUpdateTextureRegion2D Region(0, 0, 0, 0, GT_DATA_TEXTURE_WIDTH, Data.Num() / GT_DATA_TEXTURE_WIDTH);
+				RHIUpdateTexture2D(
+					Resource->TextureRHI, 0, Region, GT_DATA_TEXTURE_WIDTH * sizeof(FLinearColor),
+					reinterpret_cast<const uint8*>(Data.GetData()));
+			}
+		});
+}
+
+void FGTDataTexture::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObject(Texture);
+}
+
+FString FGTDataTexture::GetReferencerName() const
+{
+	return TEXT("FGTDataTexture");
+}
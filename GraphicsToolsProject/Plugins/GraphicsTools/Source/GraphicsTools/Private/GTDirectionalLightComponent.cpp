@@ -4,6 +4,7 @@
 #include "GTDirectionalLightComponent.h"
 
 #include "GTWorldSubsystem.h"
+#include "GraphicsTools.h"
 
 #include "Components/ArrowComponent.h"
 
@@ -58,7 +59,7 @@ void UGTDirectionalLightComponent::SetLightIntensity(float Intensity)
 	{
 		LightIntensity = Intensity;
 
-		UpdateParameterCollection();
+		MarkParameterCollectionDirty();
 	}
 }
 
@@ -68,16 +69,26 @@ void UGTDirectionalLightComponent::SetLightColor(FColor Color)
 	{
 		LightColor = Color;
 
-		UpdateParameterCollection();
+		MarkParameterCollectionDirty();
 	}
 }
 
+void UGTDirectionalLightComponent::PackLightData(FLinearColor* Data, bool IsDisabled) const
+{
+	Data[0] = FLinearColor(-GetForwardVector());
+	Data[0].A = !IsDisabled;
+
+	Data[1] = FLinearColor(GetLightColor());
+	Data[1].A = GetLightIntensity();
+}
+
 void UGTDirectionalLightComponent::SetDirectionEnabledParameterName(const FName& Name)
 {
 	if (DirectionEnabledParameterName != Name)
 	{
 		DirectionEnabledParameterName = Name;
-		UpdateParameterCollection();
+		DirectionEnabledParameterIndex = FindParameterIndex(DirectionEnabledParameterName);
+		MarkParameterCollectionDirty();
 	}
 }
 
@@ -86,7 +97,8 @@ void UGTDirectionalLightComponent::SetColorIntensityParameterName(const FName& N
 	if (ColorIntensityParameterName != Name)
 	{
 		ColorIntensityParameterName = Name;
-		UpdateParameterCollection();
+		ColorIntensityParameterIndex = FindParameterIndex(ColorIntensityParameterName);
+		MarkParameterCollectionDirty();
 	}
 }
 
@@ -132,32 +144,58 @@ void UGTDirectionalLightComponent::PostEditChangeProperty(FPropertyChangedEvent&
 }
 #endif // WITH_EDITOR
 
-TArray<UGTSceneComponent*>& UGTDirectionalLightComponent::GetWorldComponents()
+FGTComponentSlots& UGTDirectionalLightComponent::GetWorldComponents()
+{
+	return GetWorldSubsystem()->DirectionalLights;
+}
+
+void UGTDirectionalLightComponent::CacheParameterIndices()
 {
-	return GetWorld()->GetSubsystem<UGTWorldSubsystem>()->DirectionalLights;
+	DirectionEnabledParameterIndex = FindParameterIndex(DirectionEnabledParameterName);
+	ColorIntensityParameterIndex = FindParameterIndex(ColorIntensityParameterName);
 }
 
 void UGTDirectionalLightComponent::UpdateParameterCollection(bool IsDisabled)
 {
+	GT_SCOPE_CYCLE_COUNTER(STAT_GTUpdateDirectionalLight);
+
 	if (IsValid())
 	{
-		const TArray<UGTSceneComponent*>& Components = GetWorldComponents();
-		const int32 ComponentIndex = Components.Find(this);
+		if (!HasParameterCollectionOverride())
+		{
+			// Every world directional light is written to the data texture, not just the first.
+			GetWorldSubsystem()->MarkDataTextureDirty();
+		}
+
+		// Only the directional light in the first slot will be considered, or any components with an MPC override. The slot allocator moves
+		// another directional light into the first slot when it is freed.
+		if (GetWorldSlotIndex() == 0 || HasParameterCollectionOverride())
+		{
+			FLinearColor Data[2];
+			PackLightData(Data, IsDisabled);
+
+			SetVectorParameterValue(DirectionEnabledParameterIndex, Data[0]);
+			SetVectorParameterValue(ColorIntensityParameterIndex, Data[1]);
+		}
+	}
+}
+
+void UGTDirectionalLightComponent::UpdateParameterCollectionTransform()
+{
+	GT_SCOPE_CYCLE_COUNTER(STAT_GTUpdateDirectionalLight);
+
+	if (IsValid())
+	{
+		if (!HasParameterCollectionOverride())
+		{
+			GetWorldSubsystem()->MarkDataTextureDirty();
+		}
 
-		// Only the first directional light will be considered, or a disabled light in the case of removing the last light, or any
-		// components with an MPC override.
-		if (ComponentIndex == 0 || IsDisabled || HasParameterCollectionOverride())
+		if (GetWorldSlotIndex() == 0 || HasParameterCollectionOverride())
 		{
-			{
-				FLinearColor DirectionEnabled(-GetForwardVector());
-				DirectionEnabled.A = !IsDisabled;
-				SetVectorParameterValue(GetDirectionEnabledParameterName(), DirectionEnabled);
-			}
-			{
-				FLinearColor ColorIntensity(GetLightColor());
-				ColorIntensity.A = GetLightIntensity();
-				SetVectorParameterValue(GetColorIntensityParameterName(), ColorIntensity);
-			}
+			FLinearColor DirectionEnabled(-GetForwardVector());
+			DirectionEnabled.A = 1;
+			SetVectorParameterValue(DirectionEnabledParameterIndex, DirectionEnabled);
 		}
 	}
 }
@@ -0,0 +1,124 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "GTFakeHandTracker.h"
+
+#include "Features/IModularFeatures.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarFakeHandTrackerSpeed(
+	TEXT("GraphicsTools.FakeHandTracker.Speed"), 6.0f,
+	TEXT("Radians per second the fake hand tracker's hands sweep around their circle, fast motion exaggerates any lag."));
+
+static TAutoConsoleVariable<float> CVarFakeHandTrackerRadius(
+	TEXT("GraphicsTools.FakeHandTracker.Radius"), 20.0f, TEXT("Radius of the circle the fake hand tracker's hands sweep around."));
+
+namespace GTFakeHandTracker
+{
+	TUniquePtr<FGTFakeHandTracker> Instance;
+
+	void Run(const TArray<FString>& Args)
+	{
+		const bool Enable = Args.Num() > 0 ? FCString::Atoi(*Args[0]) != 0 : true;
+
+		if (Enable)
+		{
+			const FVector Origin = Args.Num() > 3
+									   ? FVector(FCString::Atof(*Args[1]), FCString::Atof(*Args[2]), FCString::Atof(*Args[3]))
+									   : FVector(50, 0, 0);
+			FGTFakeHandTracker::Register(Origin);
+		}
+		else
+		{
+			FGTFakeHandTracker::Unregister();
+		}
+	}
+} // namespace GTFakeHandTracker
+
+static FAutoConsoleCommand GTFakeHandTrackerCommand(
+	TEXT("GraphicsTools.FakeHandTracker"),
+	TEXT("Registers (or unregisters) a hand tracker whose hands sweep in a circle around a world space origin. ")
+		TEXT("Usage: GraphicsTools.FakeHandTracker [Enable=1] [OriginX=50 OriginY=0 OriginZ=0]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&GTFakeHandTracker::Run));
+
+void FGTFakeHandTracker::Register(const FVector& Origin)
+{
+	if (!GTFakeHandTracker::Instance.IsValid())
+	{
+		GTFakeHandTracker::Instance = MakeUnique<FGTFakeHandTracker>();
+		IModularFeatures::Get().RegisterModularFeature(GetModularFeatureName(), GTFakeHandTracker::Instance.Get());
+	}
+
+	GTFakeHandTracker::Instance->Origin = Origin;
+}
+
+void FGTFakeHandTracker::Unregister()
+{
+	if (GTFakeHandTracker::Instance.IsValid())
+	{
+		IModularFeatures::Get().UnregisterModularFeature(GetModularFeatureName(), GTFakeHandTracker::Instance.Get());
+		GTFakeHandTracker::Instance.Reset();
+	}
+}
+
+FName FGTFakeHandTracker::GetHandTrackerDeviceTypeName() const
+{
+	static const FName DeviceTypeName("GTFakeHandTracker");
+	return DeviceTypeName;
+}
+
+bool FGTFakeHandTracker::GetKeypointState(EControllerHand Hand, EHandKeypoint Keypoint, FTransform& OutTransform, float& OutRadius) const
+{
+	if (!IsHandPositionValid(Hand))
+	{
+		return false;
+	}
+
+	// The hands sweep in the YZ plane on opposite sides of the circle.
+	const float Angle = static_cast<float>(FPlatformTime::Seconds() * CVarFakeHandTrackerSpeed.GetValueOnAnyThread()) +
+						(Hand == EControllerHand::Left ? PI : 0.0f);
+	const FVector Center = Origin + (FVector(0, FMath::Cos(Angle), FMath::Sin(Angle)) * CVarFakeHandTrackerRadius.GetValueOnAnyThread());
+
+	OutTransform = FTransform(Center + FVector(static_cast<float>(Keypoint) * 0.5f, 0, 0));
+	OutRadius = 1;
+
+	return true;
+}
+
+bool FGTFakeHandTracker::GetAllKeypointStates(
+	EControllerHand Hand, TArray<FVector>& OutPositions, TArray<FQuat>& OutRotations, TArray<float>& OutRadii) const
+{
+	if (!IsHandPositionValid(Hand))
+	{
+		return false;
+	}
+
+	OutPositions.Reset(EHandKeypointCount);
+	OutRotations.Reset(EHandKeypointCount);
+	OutRadii.Reset(EHandKeypointCount);
+
+	for (int32 Keypoint = 0; Keypoint < EHandKeypointCount; ++Keypoint)
+	{
+		FTransform Transform;
+		float Radius;
+		GetKeypointState(Hand, static_cast<EHandKeypoint>(Keypoint), Transform, Radius);
+
+		OutPositions.Add(Transform.GetLocation());
+		OutRotations.Add(Transform.GetRotation());
+		OutRadii.Add(Radius);
+	}
+
+	return true;
+}
+
+bool FGTFakeHandTracker::GetHandMeshData(
+	EControllerHand Hand, TArray<FVector>& OutVertices, TArray<FVector>& OutNormals, TArray<int32>& OutIndices,
+	FTransform& OutHandMeshTransform) const
+{
+	return false;
+}
+
+bool FGTFakeHandTracker::IsHandPositionValid(EControllerHand DeviceHand) const
+{
+	return DeviceHand == EControllerHand::Left || DeviceHand == EControllerHand::Right;
+}
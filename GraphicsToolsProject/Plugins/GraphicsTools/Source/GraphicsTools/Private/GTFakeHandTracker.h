@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "IHandTracker.h"
+
+/**
+ * Hand tracker which reports both hands sweeping in a circle at a fixed speed, so that hand joint driven proximity lights can be tested
+ * without hand tracking hardware. Every joint of a hand moves rigidly, offset along the hand's forward axis by its keypoint index. Enable
+ * with the GraphicsTools.FakeHandTracker console command.
+ */
+class FGTFakeHandTracker : public IHandTracker
+{
+public:
+	/** Registers the fake hand tracker as an IHandTracker modular feature, the hands orbit Origin. */
+	static void Register(const FVector& Origin);
+
+	/** Unregisters the fake hand tracker if registered. */
+	static void Unregister();
+
+	//
+	// IHandTracker interface
+
+	virtual FName GetHandTrackerDeviceTypeName() const override;
+	virtual bool IsHandTrackingStateValid() const override { return true; }
+	virtual bool GetKeypointState(EControllerHand Hand, EHandKeypoint Keypoint, FTransform& OutTransform, float& OutRadius) const override;
+	virtual bool GetAllKeypointStates(
+		EControllerHand Hand, TArray<FVector>& OutPositions, TArray<FQuat>& OutRotations, TArray<float>& OutRadii) const override;
+	virtual bool HasHandMeshData() const override { return false; }
+	virtual bool GetHandMeshData(
+		EControllerHand Hand, TArray<FVector>& OutVertices, TArray<FVector>& OutNormals, TArray<int32>& OutIndices,
+		FTransform& OutHandMeshTransform) const override;
+	virtual bool IsHandPositionValid(EControllerHand DeviceHand) const override;
+
+private:
+	/** The center of the circle both hands sweep around. */
+	FVector Origin = FVector::ZeroVector;
+};
@@ -101,6 +101,8 @@ void UGTMeshOutlineComponent::PostEditChangeProperty(FPropertyChangedEvent& Prop
 
 void UGTMeshOutlineComponent::UpdateMaterial()
 {
+	GT_SCOPE_CYCLE_COUNTER(STAT_GTUpdateMeshOutlineMaterial);
+
 	UMaterialInterface* Material = GetMaterial(0);
 
 	if (Material == nullptr)
@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "GTParameterCollectionBuffer.h"
+
+#include "Engine/World.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+
+FGTParameterCollectionBuffer::FGTParameterCollectionBuffer(UWorld* InWorld, const UMaterialParameterCollection* InCollection)
+	: World(InWorld)
+	, Collection(InCollection)
+{
+	Rebuild();
+}
+
+int32 FGTParameterCollectionBuffer::FindParameterIndex(FName ParameterName) const
+{
+	return ParameterNames.IndexOfByKey(ParameterName);
+}
+
+void FGTParameterCollectionBuffer::Flush()
+{
+	NumWrites = 0;
+
+	if (!bDirty)
+	{
+		NumSkippedWrites = PendingSkippedWrites;
+		PendingSkippedWrites = 0;
+		return;
+	}
+
+	if (UMaterialParameterCollectionInstance* CollectionInstance = Instance.Get())
+	{
+		for (TConstSetBitIterator<> It(DirtyParameters); It; ++It)
+		{
+			const int32 ParameterIndex = It.GetIndex();
+
+			// A value may have been changed and then restored within the same frame.
+			if (UploadedValues[ParameterIndex] == Values[ParameterIndex])
+			{
+				++PendingSkippedWrites;
+				continue;
+			}
+
+			CollectionInstance->SetVectorParameterValue(ParameterNames[ParameterIndex], Values[ParameterIndex]);
+			UploadedValues[ParameterIndex] = Values[ParameterIndex];
+			++NumWrites;
+		}
+	}
+
+	DirtyParameters.SetRange(0, DirtyParameters.Num(), false);
+	bDirty = false;
+	NumSkippedWrites = PendingSkippedWrites;
+	PendingSkippedWrites = 0;
+}
+
+#if WITH_EDITOR
+bool FGTParameterCollectionBuffer::IsStale() const
+{
+	const UMaterialParameterCollection* CurrentCollection = Collection.Get();
+	return (CurrentCollection != nullptr && CurrentCollection->StateId != StateId);
+}
+#endif // WITH_EDITOR
+
+void FGTParameterCollectionBuffer::Rebuild()
+{
+	ParameterNames.Reset();
+	Values.Reset();
+	UploadedValues.Reset();
+	Instance.Reset();
+
+	UWorld* CurrentWorld = World.Get();
+	const UMaterialParameterCollection* CurrentCollection = Collection.Get();
+
+	if (CurrentWorld != nullptr && CurrentCollection != nullptr)
+	{
+		StateId = CurrentCollection->StateId;
+		Instance = CurrentWorld->GetParameterCollectionInstance(CurrentCollection);
+
+		for (const FCollectionVectorParameter& Parameter : CurrentCollection->VectorParameters)
+		{
+			FLinearColor Value = Parameter.DefaultValue;
+
+			if (Instance.IsValid())
+			{
+				Instance->GetVectorParameterValue(Parameter.ParameterName, Value);
+			}
+
+			ParameterNames.Add(Parameter.ParameterName);
+			Values.Add(Value);
+		}
+	}
+
+	UploadedValues = Values;
+	DirtyParameters.Init(false, ParameterNames.Num());
+	bDirty = false;
+	++Version;
+}
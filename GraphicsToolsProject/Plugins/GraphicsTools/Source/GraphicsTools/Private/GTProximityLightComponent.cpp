@@ -3,17 +3,19 @@
 
 #include "GTProximityLightComponent.h"
 
+#include "GTDataTexture.h"
 #include "GTWorldSubsystem.h"
 #include "GraphicsTools.h"
 
-#define GT_MAX_PROXIMITY_LIGHTS 3
+#include "IHandTracker.h"
+
+static TAutoConsoleVariable<float> CVarProximityLightPulseRelevance(
+	TEXT("GraphicsTools.ProximityLightPulseRelevance"), 2.0f,
+	TEXT("Relevance multiplier applied to proximity lights which are pulsing, so that pulses are not culled when more than three proximity ")
+		TEXT("lights exist."));
 
 UGTProximityLightComponent::UGTProximityLightComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
-	// Don't start ticking until the light needs to be animated.
-	PrimaryComponentTick.bStartWithTickEnabled = false;
-
 	{
 		static const FName ParameterNames[GT_MAX_PROXIMITY_LIGHTS] = {
 			"ProximityLightLocation0", "ProximityLightLocation1", "ProximityLightLocation2"};
@@ -57,7 +59,7 @@ void UGTProximityLightComponent::SetProjectedRadius(float Radius)
 			AttenuationRadius = ProjectedRadius;
 		}
 
-		UpdateParameterCollection();
+		MarkParameterCollectionDirty();
 	}
 }
 
@@ -72,7 +74,7 @@ void UGTProximityLightComponent::SetAttenuationRadius(float Radius)
 			ProjectedRadius = AttenuationRadius;
 		}
 
-		UpdateParameterCollection();
+		MarkParameterCollectionDirty();
 	}
 }
 
@@ -82,7 +84,7 @@ void UGTProximityLightComponent::SetShrinkDistance(float Distance)
 	{
 		ShrinkDistance = FMath::Clamp(Distance, 1.0f, 500.0f);
 
-		UpdateParameterCollection();
+		MarkParameterCollectionDirty();
 	}
 }
 
@@ -92,7 +94,7 @@ void UGTProximityLightComponent::SetShrinkPercentage(float Percentage)
 	{
 		ShrinkPercentage = FMath::Clamp(Percentage, 0.0f, 1.0f);
 
-		UpdateParameterCollection();
+		MarkParameterCollectionDirty();
 	}
 }
 
@@ -102,7 +104,7 @@ void UGTProximityLightComponent::SetCenterColor(FColor Color)
 	{
 		CenterColor = Color;
 
-		UpdateParameterCollection();
+		MarkParameterCollectionDirty();
 	}
 }
 
@@ -112,7 +114,7 @@ void UGTProximityLightComponent::SetMiddleColor(FColor Color)
 	{
 		MiddleColor = Color;
 
-		UpdateParameterCollection();
+		MarkParameterCollectionDirty();
 	}
 }
 
@@ -122,7 +124,46 @@ void UGTProximityLightComponent::SetOuterColor(FColor Color)
 	{
 		OuterColor = Color;
 
-		UpdateParameterCollection();
+		MarkParameterCollectionDirty();
+	}
+}
+
+void UGTProximityLightComponent::SetFollowHandJoint(bool Follow)
+{
+	if (bFollowHandJoint != Follow)
+	{
+		bFollowHandJoint = Follow;
+		ResetHandJoint();
+
+		if (UGTWorldSubsystem* Subsystem = GetWorldSubsystem())
+		{
+			if (bFollowHandJoint)
+			{
+				Subsystem->AddHandJointLight(this);
+			}
+			else
+			{
+				Subsystem->RemoveHandJointLight(this);
+			}
+		}
+	}
+}
+
+void UGTProximityLightComponent::SetTrackedHand(EControllerHand Hand)
+{
+	if (TrackedHand != Hand)
+	{
+		TrackedHand = Hand;
+		ResetHandJoint();
+	}
+}
+
+void UGTProximityLightComponent::SetTrackedHandJoint(EHandKeypoint Joint)
+{
+	if (TrackedHandJoint != Joint)
+	{
+		TrackedHandJoint = Joint;
+		ResetHandJoint();
 	}
 }
 
@@ -131,7 +172,8 @@ void UGTProximityLightComponent::SetLocationParameterNames(const TArray<FName>&
 	if (Names.Num() >= GT_MAX_PROXIMITY_LIGHTS)
 	{
 		LocationParameterNames = Names;
-		UpdateParameterCollection();
+		FindParameterIndices(LocationParameterNames, LocationParameterIndices);
+		MarkParameterCollectionDirty();
 	}
 	else
 	{
@@ -146,7 +188,8 @@ void UGTProximityLightComponent::SetSettingsParameterNames(const TArray<FName>&
 	if (Names.Num() >= GT_MAX_PROXIMITY_LIGHTS)
 	{
 		SettingsParameterNames = Names;
-		UpdateParameterCollection();
+		FindParameterIndices(SettingsParameterNames, SettingsParameterIndices);
+		MarkParameterCollectionDirty();
 	}
 	else
 	{
@@ -161,7 +204,8 @@ void UGTProximityLightComponent::SetPulseSettingsParameterNames(const TArray<FNa
 	if (Names.Num() >= GT_MAX_PROXIMITY_LIGHTS)
 	{
 		PulseSettingsParameterNames = Names;
-		UpdateParameterCollection();
+		FindParameterIndices(PulseSettingsParameterNames, PulseSettingsParameterIndices);
+		MarkParameterCollectionDirty();
 	}
 	else
 	{
@@ -176,7 +220,8 @@ void UGTProximityLightComponent::SetCenterColorParameterNames(const TArray<FName
 	if (Names.Num() >= GT_MAX_PROXIMITY_LIGHTS)
 	{
 		CenterColorParameterNames = Names;
-		UpdateParameterCollection();
+		FindParameterIndices(CenterColorParameterNames, CenterColorParameterIndices);
+		MarkParameterCollectionDirty();
 	}
 	else
 	{
@@ -191,7 +236,8 @@ void UGTProximityLightComponent::SetMiddleColorParameterNames(const TArray<FName
 	if (Names.Num() >= GT_MAX_PROXIMITY_LIGHTS)
 	{
 		MiddleColorParameterNames = Names;
-		UpdateParameterCollection();
+		FindParameterIndices(MiddleColorParameterNames, MiddleColorParameterIndices);
+		MarkParameterCollectionDirty();
 	}
 	else
 	{
@@ -206,7 +252,8 @@ void UGTProximityLightComponent::SetOuterColorParameterNames(const TArray<FName>
 	if (Names.Num() >= GT_MAX_PROXIMITY_LIGHTS)
 	{
 		OuterColorParameterNames = Names;
-		UpdateParameterCollection();
+		FindParameterIndices(OuterColorParameterNames, OuterColorParameterIndices);
+		MarkParameterCollectionDirty();
 	}
 	else
 	{
@@ -218,37 +265,65 @@ void UGTProximityLightComponent::SetOuterColorParameterNames(const TArray<FName>
 
 void UGTProximityLightComponent::Pulse(float Duration, float FadeOffset, float FadeDuration)
 {
-	if (PulseState == EPulseState::Idle && Duration > 0)
+	if (UGTWorldSubsystem* Subsystem = GetWorldSubsystem())
 	{
-		PulseState = EPulseState::Animate;
-		PulseTimer = 0;
-		PulseFadeTimer = 0;
-		PulseDuration = Duration;
-		PulseFadeOffset = FadeOffset;
-		PulseFadeDuration = FadeDuration;
-
-		SetComponentTickEnabled(true);
+		Subsystem->StartProximityLightPulse(this, Duration, FadeOffset, FadeDuration);
 	}
 }
 
-float UGTProximityLightComponent::GetPulseTime() const
+float UGTProximityLightComponent::CalculateRelevance(const TArray<FVector>& ViewLocations) const
 {
-	if (PulseDuration > 0)
+	float Relevance = 1;
+
+	// When no views have been rendered yet, rank lights by intensity and pulse state alone.
+	if (ViewLocations.Num() != 0)
+	{
+		const FVector Location = GetComponentLocation();
+		float DistanceSquared = MAX_flt;
+
+		for (const FVector& ViewLocation : ViewLocations)
+		{
+			DistanceSquared = FMath::Min(DistanceSquared, FVector::DistSquared(Location, ViewLocation));
+		}
+
+		// Lights with a larger attenuation radius are visible from further away.
+		Relevance = GetAttenuationRadius() / (GetAttenuationRadius() + FMath::Sqrt(DistanceSquared));
+	}
+
+	const float Intensity = FMath::Max3(
+		FVector3f(FLinearColor(GetCenterColor())).GetMax(), FVector3f(FLinearColor(GetMiddleColor())).GetMax(),
+		FVector3f(FLinearColor(GetOuterColor())).GetMax());
+	Relevance *= Intensity;
+
+	if (PulseState != EPulseState::Idle)
 	{
-		return FMath::Clamp(PulseTimer / PulseDuration, 0.0f, 1.0f);
+		Relevance *= CVarProximityLightPulseRelevance.GetValueOnGameThread();
 	}
 
-	return 0;
+	return Relevance;
 }
 
-float UGTProximityLightComponent::GetPulseFadeTime() const
+void UGTProximityLightComponent::PackLightData(FLinearColor* Data, bool IsDisabled) const
 {
-	if (PulseFadeDuration > 0)
-	{
-		return FMath::Clamp(PulseFadeTimer / PulseFadeDuration, 0.0f, 1.0f);
-	}
+	Data[0] = FLinearColor(GetComponentLocation());
+	Data[0].A = !IsDisabled;
+
+	const float PulseScaler = 1.0f + GetPulseTime();
+	Data[1] = FLinearColor(
+		GetProjectedRadius() * PulseScaler, 1.0f / GetAttenuationRadius() * PulseScaler, 1.0f / GetShrinkDistance() * PulseScaler,
+		GetShrinkPercentage());
+	Data[2] = FLinearColor(GetProjectedRadius() * GetPulseTime(), 1.0f - GetPulseFadeTime(), GetInfluenceRadius(), 0.0f);
+
+	Data[3] = GetCenterColor();
+	Data[4] = GetMiddleColor();
+	Data[5] = GetOuterColor();
+}
 
-	return 0;
+float UGTProximityLightComponent::GetInfluenceRadius() const
+{
+	// Surfaces further than the attenuation radius along their normal, or further than the (pulsed) projected radius across their surface,
+	// are not lit.
+	return FMath::Sqrt(FMath::Square(GetAttenuationRadius()) + FMath::Square(GetProjectedRadius() * (1.0f + GetPulseTime())));
 }
 
 #if WITH_EDITOR
@@ -273,17 +348,27 @@ bool UGTProximityLightComponent::CanEditChange(const FProperty* Property) const
 }
 #endif // WITH_EDITOR
 
-void UGTProximityLightComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UGTProximityLightComponent::OnRegister()
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	Super::OnRegister();
 
-	PulseState = PulseTick(DeltaTime);
-	UpdateParameterCollection();
+	if (bFollowHandJoint && GetWorldSubsystem() != nullptr)
+	{
+		GetWorldSubsystem()->AddHandJointLight(this);
+	}
+}
 
-	if (PulseState == EPulseState::Idle)
+void UGTProximityLightComponent::OnUnregister()
+{
+	// The world subsystem is released by the super class.
+	if (GetWorldSubsystem() != nullptr)
 	{
-		SetComponentTickEnabled(false);
+		GetWorldSubsystem()->RemoveHandJointLight(this);
 	}
+
+	ResetHandJoint();
+
+	Super::OnUnregister();
 }
 
 #if WITH_EDITOR
@@ -351,111 +436,176 @@ void UGTProximityLightComponent::PostEditChangeProperty(FPropertyChangedEvent& P
 			OuterColorParameterNames.Add(FName());
 		}
 	}
+	else if (
+		PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UGTProximityLightComponent, TrackedHand) ||
+		PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UGTProximityLightComponent, TrackedHandJoint))
+	{
+		// The last sample belongs to a different joint.
+		ResetHandJoint();
+	}
 
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 }
 #endif // WITH_EDITOR
 
-TArray<UGTSceneComponent*>& UGTProximityLightComponent::GetWorldComponents()
+FGTComponentSlots& UGTProximityLightComponent::GetWorldComponents()
+{
+	return GetWorldSubsystem()->ProximityLights;
+}
+
+int32 UGTProximityLightComponent::GetNumActiveWorldSlots() const
 {
-	return GetWorld()->GetSubsystem<UGTWorldSubsystem>()->ProximityLights;
+	return 0;
+}
+
+void UGTProximityLightComponent::RemoveFromWorldParameterCollection()
+{
+	// Disables the selected slot, if any, before it is released.
+	Super::RemoveFromWorldParameterCollection();
+
+	if (UGTWorldSubsystem* Subsystem = GetWorldSubsystem())
+	{
+		Subsystem->ReleaseProximityLightSlot(this);
+		Subsystem->StopProximityLightPulse(this);
+	}
+}
+
+void UGTProximityLightComponent::CacheParameterIndices()
+{
+	FindParameterIndices(LocationParameterNames, LocationParameterIndices);
+	FindParameterIndices(SettingsParameterNames, SettingsParameterIndices);
+	FindParameterIndices(PulseSettingsParameterNames, PulseSettingsParameterIndices);
+	FindParameterIndices(CenterColorParameterNames, CenterColorParameterIndices);
+	FindParameterIndices(MiddleColorParameterNames, MiddleColorParameterIndices);
+	FindParameterIndices(OuterColorParameterNames, OuterColorParameterIndices);
 }
 
 void UGTProximityLightComponent::UpdateParameterCollection(bool IsDisabled)
 {
+	GT_SCOPE_CYCLE_COUNTER(STAT_GTUpdateProximityLight);
+
 	if (IsValid())
 	{
-		// When the proximity light has a material parameter collection override, assume the light is index zero.
-		int32 ComponentIndex = 0;
-
 		if (!HasParameterCollectionOverride())
 		{
-			const TArray<UGTSceneComponent*>& Components = GetWorldComponents();
-			ComponentIndex = Components.Find(this);
+			// Every world proximity light is written to the data texture, not just the selected lights.
+			GetWorldSubsystem()->MarkDataTextureDirty();
 		}
 
+		// When the proximity light has a material parameter collection override, assume the light is index zero. Else use the slot the
+		// world subsystem selected for the light.
+		const int32 ComponentIndex = HasParameterCollectionOverride() ? 0 : ParameterCollectionSlot;
+
 		if (ComponentIndex != INDEX_NONE && ComponentIndex < GT_MAX_PROXIMITY_LIGHTS)
 		{
-			{
-				FLinearColor Location(GetComponentLocation());
-				Location.A = !IsDisabled;
-				SetVectorParameterValue(GetLocationParameterNames()[ComponentIndex], Location);
-			}
-			{
-				const float PulseScaler = 1.0f + GetPulseTime();
-				SetVectorParameterValue(
-					GetSettingsParameterNames()[ComponentIndex],
-					FLinearColor(
-						GetProjectedRadius() * PulseScaler, 1.0f / GetAttenuationRadius() * PulseScaler,
-						1.0f / GetShrinkDistance() * PulseScaler, GetShrinkPercentage()));
-			}
-			{
-				SetVectorParameterValue(
-					GetPulseSettingsParameterNames()[ComponentIndex],
-					FLinearColor(GetProjectedRadius() * GetPulseTime(), 1.0f - GetPulseFadeTime(), 0.0f, 0.0f));
-			}
-			{
-				SetVectorParameterValue(GetCenterColorParameterNames()[ComponentIndex], GetCenterColor());
-				SetVectorParameterValue(GetMiddleColorParameterNames()[ComponentIndex], GetMiddleColor());
-				SetVectorParameterValue(GetOuterColorParameterNames()[ComponentIndex], GetOuterColor());
-			}
+			FLinearColor Data[GT_DATA_TEXTURE_PROXIMITY_LIGHT_TEXELS];
+			PackLightData(Data, IsDisabled);
+
+			SetVectorParameterValue(LocationParameterIndices[ComponentIndex], Data[0]);
+			SetVectorParameterValue(SettingsParameterIndices[ComponentIndex], Data[1]);
+			SetVectorParameterValue(PulseSettingsParameterIndices[ComponentIndex], Data[2]);
+			SetVectorParameterValue(CenterColorParameterIndices[ComponentIndex], Data[3]);
+			SetVectorParameterValue(MiddleColorParameterIndices[ComponentIndex], Data[4]);
+			SetVectorParameterValue(OuterColorParameterIndices[ComponentIndex], Data[5]);
 		}
 	}
 }
 
-EPulseState UGTProximityLightComponent::PulseTick(float DeltaTime)
+void UGTProximityLightComponent::UpdateParameterCollectionTransform()
 {
-	switch (PulseState)
-	{
-	case EPulseState::Animate:
+	GT_SCOPE_CYCLE_COUNTER(STAT_GTUpdateProximityLight);
+
+	if (IsValid())
 	{
-		// Animate the PulseTime from 0 to PulseDuration.
-		if (PulseTimer < PulseDuration)
+		if (!HasParameterCollectionOverride())
 		{
-			PulseTimer = FMath::Clamp(PulseTimer + DeltaTime, 0.0f, PulseDuration);
+			GetWorldSubsystem()->MarkDataTextureDirty();
+		}
 
-			// Fade in the pulse.
-			if (PulseTimer >= PulseFadeOffset && PulseFadeTimer < PulseFadeDuration)
-			{
-				PulseFadeTimer = FMath::Clamp(PulseFadeTimer + DeltaTime, 0.0f, PulseFadeDuration);
-			}
+		const int32 ComponentIndex = HasParameterCollectionOverride() ? 0 : ParameterCollectionSlot;
 
-			return EPulseState::Animate;
+		if (ComponentIndex != INDEX_NONE && ComponentIndex < GT_MAX_PROXIMITY_LIGHTS)
+		{
+			FLinearColor Location(GetComponentLocation());
+			Location.A = 1;
+			SetVectorParameterValue(LocationParameterIndices[ComponentIndex], Location);
 		}
-
-		PulseTimer = PulseDuration;
-		return EPulseState::FadeIn;
 	}
-	case EPulseState::FadeIn:
+}
+
+void UGTProximityLightComponent::UpdateParameterCollectionPulse()
+{
+	GT_SCOPE_CYCLE_COUNTER(STAT_GTUpdateProximityLight);
+
+	if (IsValid())
 	{
-		// Continue to fade in the pulse, animate the PulseFade to PulseFadeDuration (if it's not already there).
-		if (PulseFadeTimer < PulseFadeDuration)
+		if (!HasParameterCollectionOverride())
 		{
-			PulseFadeTimer = FMath::Clamp(PulseFadeTimer + DeltaTime, 0.0f, PulseFadeDuration);
-
-			return EPulseState::FadeIn;
+			GetWorldSubsystem()->MarkDataTextureDirty();
 		}
 
-		// Reset the pulse once completely faded.
-		PulseTimer = 0;
-		return EPulseState::FadeOut;
-	}
-	case EPulseState::FadeOut:
-	{
-		// Fade out the pulse, animate the PulseFadeTimer to 0.
-		if (PulseFadeTimer > 0)
+		const int32 ComponentIndex = HasParameterCollectionOverride() ? 0 : ParameterCollectionSlot;
+
+		if (ComponentIndex != INDEX_NONE && ComponentIndex < GT_MAX_PROXIMITY_LIGHTS)
 		{
-			PulseFadeTimer = FMath::Clamp(PulseFadeTimer - DeltaTime, 0.0f, PulseFadeDuration);
+			// Only the settings (scaled by the pulse) and the pulse settings change as a pulse animates.
+			FLinearColor Data[GT_DATA_TEXTURE_PROXIMITY_LIGHT_TEXELS];
+			PackLightData(Data);
 
-			return EPulseState::FadeOut;
+			SetVectorParameterValue(SettingsParameterIndices[ComponentIndex], Data[1]);
+			SetVectorParameterValue(PulseSettingsParameterIndices[ComponentIndex], Data[2]);
 		}
+	}
+}
+
+void UGTProximityLightComponent::UpdateHandJoint(const IHandTracker* HandTracker, double Time)
+{
+	FTransform JointTransform;
+	float JointRadius;
+
+	if (HandTracker == nullptr || !HandTracker->GetKeypointState(TrackedHand, TrackedHandJoint, JointTransform, JointRadius))
+	{
+		// Leave the light where the joint was last seen.
+		ResetHandJoint();
+		return;
+	}
+
+	const FVector Location = JointTransform.GetLocation();
 
-		// The animation is complete.
-		PulseFadeTimer = 0;
+	// The game thread can run faster than the tracker, a recently sampled pose which is unchanged is the previous sample rather than a
+	// joint at rest.
+	if (bHandJointTracked && Location.Equals(HandJointLocation, 0) && (Time - HandJointSampleTime) < FGTDataTexture::MaxPredictionTime)
+	{
+		SetWorldLocation(PredictHandJointLocation(Time + HandJointPredictionTime));
+		return;
+	}
 
-		return EPulseState::Idle;
+	if (bHandJointTracked && Time > HandJointSampleTime)
+	{
+		// Average the velocity with the previous estimate to reduce the effect of tracking noise on the extrapolation.
+		const FVector Velocity = (Location - HandJointLocation) / (Time - HandJointSampleTime);
+		HandJointVelocity = FMath::Lerp(HandJointVelocity, Velocity, 0.5f);
 	}
-	default:
-		return EPulseState::Idle;
+	else
+	{
+		HandJointVelocity = FVector::ZeroVector;
 	}
-}
\ No newline at end of file
+
+	HandJointLocation = Location;
+	HandJointSampleTime = Time;
+	bHandJointTracked = true;
+
+	SetWorldLocation(PredictHandJointLocation(Time + HandJointPredictionTime));
+}
+
+void UGTProximityLightComponent::ResetHandJoint()
+{
+	HandJointVelocity = FVector::ZeroVector;
+	HandJointSampleTime = 0;
+	bHandJointTracked = false;
+}
+
+FVector UGTProximityLightComponent::PredictHandJointLocation(double Time) const
+{
+	return HandJointLocation + (HandJointVelocity * (Time - HandJointSampleTime));
+}
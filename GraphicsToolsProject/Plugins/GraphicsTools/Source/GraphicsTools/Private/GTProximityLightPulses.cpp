@@ -0,0 +1,146 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "GTProximityLightPulses.h"
+
+#include "GTProximityLightComponent.h"
+
+bool FGTProximityLightPulses::Add(UGTProximityLightComponent* Light, float Duration, float FadeOffset, float FadeDuration)
+{
+	if (Light->PulseIndex != INDEX_NONE || Duration <= 0)
+	{
+		return false;
+	}
+
+	Light->PulseIndex = Lights.Add(Light);
+	Light->PulseState = EPulseState::Animate;
+	Light->PulseTime = 0;
+	Light->PulseFadeTime = 0;
+
+	States.Add(EPulseState::Animate);
+	Timers.Add(0);
+	FadeTimers.Add(0);
+	Durations.Add(Duration);
+	FadeOffsets.Add(FadeOffset);
+	FadeDurations.Add(FadeDuration);
+
+	return true;
+}
+
+void FGTProximityLightPulses::Remove(UGTProximityLightComponent* Light)
+{
+	if (Light->PulseIndex != INDEX_NONE)
+	{
+		RemoveAtSwap(Light->PulseIndex);
+
+		Light->PulseState = EPulseState::Idle;
+		Light->PulseTime = 0;
+		Light->PulseFadeTime = 0;
+	}
+}
+
+void FGTProximityLightPulses::Update(float DeltaTime, TArray<UGTProximityLightComponent*>& OutUpdatedLights)
+{
+	const int32 NumPulses = Lights.Num();
+
+	for (int32 Index = 0; Index < NumPulses; ++Index)
+	{
+		States[Index] = Advance(Index, DeltaTime);
+	}
+
+	OutUpdatedLights.Append(Lights);
+
+	// Iterate backwards so that swap removal only moves pulses which have already been visited.
+	for (int32 Index = NumPulses - 1; Index >= 0; --Index)
+	{
+		UGTProximityLightComponent* Light = Lights[Index];
+		Light->PulseState = States[Index];
+		Light->PulseTime = Durations[Index] > 0 ? FMath::Clamp(Timers[Index] / Durations[Index], 0.0f, 1.0f) : 0;
+		Light->PulseFadeTime = FadeDurations[Index] > 0 ? FMath::Clamp(FadeTimers[Index] / FadeDurations[Index], 0.0f, 1.0f) : 0;
+
+		if (States[Index] == EPulseState::Idle)
+		{
+			RemoveAtSwap(Index);
+		}
+	}
+}
+
+EPulseState FGTProximityLightPulses::Advance(int32 Index, float DeltaTime)
+{
+	float& Timer = Timers[Index];
+	float& FadeTimer = FadeTimers[Index];
+	const float Duration = Durations[Index];
+	const float FadeDuration = FadeDurations[Index];
+
+	switch (States[Index])
+	{
+	case EPulseState::Animate:
+	{
+		// Animate the PulseTime from 0 to PulseDuration.
+		if (Timer < Duration)
+		{
+			Timer = FMath::Clamp(Timer + DeltaTime, 0.0f, Duration);
+
+			// Fade in the pulse.
+			if (Timer >= FadeOffsets[Index] && FadeTimer < FadeDuration)
+			{
+				FadeTimer = FMath::Clamp(FadeTimer + DeltaTime, 0.0f, FadeDuration);
+			}
+
+			return EPulseState::Animate;
+		}
+
+		Timer = Duration;
+		return EPulseState::FadeIn;
+	}
+	case EPulseState::FadeIn:
+	{
+		// Continue to fade in the pulse, animate the PulseFade to PulseFadeDuration (if it's not already there).
+		if (FadeTimer < FadeDuration)
+		{
+			FadeTimer = FMath::Clamp(FadeTimer + DeltaTime, 0.0f, FadeDuration);
+
+			return EPulseState::FadeIn;
+		}
+
+		// Reset the pulse once completely faded.
+		Timer = 0;
+		return EPulseState::FadeOut;
+	}
+	case EPulseState::FadeOut:
+	{
+		// Fade out the pulse, animate the PulseFadeTimer to 0.
+		if (FadeTimer > 0)
+		{
+			FadeTimer = FMath::Clamp(FadeTimer - DeltaTime, 0.0f, FadeDuration);
+
+			return EPulseState::FadeOut;
+		}
+
+		// The animation is complete.
+		FadeTimer = 0;
+
+		return EPulseState::Idle;
+	}
+	default:
+		return EPulseState::Idle;
+	}
+}
+
+void FGTProximityLightPulses::RemoveAtSwap(int32 Index)
+{
+	Lights[Index]->PulseIndex = INDEX_NONE;
+
+	Lights.RemoveAtSwap(Index, 1, false);
+	States.RemoveAtSwap(Index, 1, false);
+	Timers.RemoveAtSwap(Index, 1, false);
+	FadeTimers.RemoveAtSwap(Index, 1, false);
+	Durations.RemoveAtSwap(Index, 1, false);
+	FadeOffsets.RemoveAtSwap(Index, 1, false);
+	FadeDurations.RemoveAtSwap(Index, 1, false);
+
+	if (Lights.IsValidIndex(Index))
+	{
+		Lights[Index]->PulseIndex = Index;
+	}
+}
@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "GTProximityLightSurfaceComponent.h"
+
+#include "GTWorldSubsystem.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+void UGTProximityLightSurfaceComponent::RefreshPrimitives()
+{
+	Primitives.Reset();
+
+	if (AActor* Owner = GetOwner())
+	{
+		TInlineComponentArray<UPrimitiveComponent*> OwnerPrimitives(Owner);
+
+		for (UPrimitiveComponent* Primitive : OwnerPrimitives)
+		{
+			Primitives.Add(Primitive);
+		}
+	}
+}
+
+void UGTProximityLightSurfaceComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	RefreshPrimitives();
+
+	if (UWorld* World = GetWorld())
+	{
+		if (UGTWorldSubsystem* Subsystem = World->GetSubsystem<UGTWorldSubsystem>())
+		{
+			Subsystem->AddProximityLightSurface(this);
+		}
+	}
+}
+
+void UGTProximityLightSurfaceComponent::OnUnregister()
+{
+	Super::OnUnregister();
+
+	if (UWorld* World = GetWorld())
+	{
+		if (UGTWorldSubsystem* Subsystem = World->GetSubsystem<UGTWorldSubsystem>())
+		{
+			Subsystem->RemoveProximityLightSurface(this);
+		}
+	}
+
+	Primitives.Reset();
+}
@@ -3,6 +3,7 @@
 
 #include "GTSceneComponent.h"
 
+#include "GTParameterCollectionBuffer.h"
 #include "GTWorldSubsystem.h"
 #include "GraphicsTools.h"
 
@@ -11,7 +12,7 @@
 #include "Materials/MaterialParameterCollectionInstance.h"
 #include "UObject/ConstructorHelpers.h"
 
-TArray<UGTSceneComponent*> UGTSceneComponent::Empty;
+FGTComponentSlots UGTSceneComponent::Empty;
 
 UGTSceneComponent::UGTSceneComponent()
 {
@@ -40,6 +41,7 @@ void UGTSceneComponent::SetParameterCollectionOverride(UMaterialParameterCollect
 {
 	RemoveFromWorldParameterCollection();
 	ParameterCollectionOverride = (Override == WorldParameterCollection) ? nullptr : Override;
+	CacheParameterCollection();
 	AddToWorldParameterCollection();
 }
 
@@ -47,6 +49,9 @@ void UGTSceneComponent::OnRegister()
 {
 	Super::OnRegister();
 
+	WorldSubsystem = GetWorld()->GetSubsystem<UGTWorldSubsystem>();
+	CacheParameterCollection();
+
 	if (IsVisible())
 	{
 		AddToWorldParameterCollection();
@@ -66,6 +71,9 @@ void UGTSceneComponent::OnUnregister()
 	Super::OnUnregister();
 
 	RemoveFromWorldParameterCollection();
+
+	WorldSubsystem = nullptr;
+	ParameterCollectionBuffer.Reset();
 }
 
 void UGTSceneComponent::OnVisibilityChanged()
@@ -86,13 +94,32 @@ void UGTSceneComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransformF
 {
 	Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
 
-	UpdateParameterCollection();
+	MarkParameterCollectionTransformDirty();
 }
 
 #if WITH_EDITOR
+void UGTSceneComponent::PreEditChange(FProperty* PropertyAboutToChange)
+{
+	Super::PreEditChange(PropertyAboutToChange);
+
+	if (PropertyAboutToChange != nullptr &&
+		PropertyAboutToChange->GetFName() == GET_MEMBER_NAME_CHECKED(UGTSceneComponent, ParameterCollectionOverride))
+	{
+		RemoveFromWorldParameterCollection();
+	}
+}
+
 void UGTSceneComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
-	UpdateParameterCollection();
+	// Parameter names or the collection override may have changed.
+	CacheParameterCollection();
+
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UGTSceneComponent, ParameterCollectionOverride) && IsVisible())
+	{
+		AddToWorldParameterCollection();
+	}
+
+	MarkParameterCollectionDirty();
 
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 }
@@ -102,8 +129,8 @@ bool UGTSceneComponent::IsValid() const
 {
 	// Ensure the world isn't being destroyed since any systems storing soft pointers may assert.
 	return (
-		!IsEngineExitRequested() && GetWorld() != nullptr && GetWorld()->HasAnyFlags(RF_BeginDestroyed) == false &&
-		GetWorld()->GetSubsystem<UGTWorldSubsystem>() != nullptr && GetParameterCollection() != nullptr);
+		!IsEngineExitRequested() && WorldSubsystem != nullptr && ParameterCollectionBuffer.IsValid() &&
+		GetWorld()->HasAnyFlags(RF_BeginDestroyed) == false && GetParameterCollection() != nullptr);
 }
 
 const UMaterialParameterCollection* UGTSceneComponent::GetParameterCollection() const
@@ -120,21 +147,41 @@ const UMaterialParameterCollection* UGTSceneComponent::GetParameterCollection()
 	return CurrentCollection;
 }
 
-bool UGTSceneComponent::SetVectorParameterValue(FName ParameterName, const FLinearColor& ParameterValue)
+int32 UGTSceneComponent::FindParameterIndex(FName ParameterName) const
 {
-	UMaterialParameterCollectionInstance* ParameterCollectionInstance =
-		GetWorld()->GetParameterCollectionInstance(GetParameterCollection());
-
-	if (ParameterCollectionInstance != nullptr)
+	if (!ParameterCollectionBuffer.IsValid() || ParameterName.IsNone())
 	{
-		if (ParameterCollectionInstance->SetVectorParameterValue(ParameterName, ParameterValue))
-		{
-			return true;
-		}
+		return INDEX_NONE;
+	}
+
+	const int32 ParameterIndex = ParameterCollectionBuffer->FindParameterIndex(ParameterName);
 
+	if (ParameterIndex == INDEX_NONE)
+	{
 		UE_LOG(
 			GraphicsTools, Warning, TEXT("Unable to find %s parameter in material parameter collection %s."), *ParameterName.ToString(),
-			*ParameterCollectionInstance->GetCollection()->GetPathName());
+			*GetPathNameSafe(ParameterCollectionBuffer->GetCollection()));
+	}
+
+	return ParameterIndex;
+}
+
+void UGTSceneComponent::FindParameterIndices(const TArray<FName>& ParameterNames, TArray<int32>& OutParameterIndices) const
+{
+	OutParameterIndices.Reset(ParameterNames.Num());
+
+	for (const FName& ParameterName : ParameterNames)
+	{
+		OutParameterIndices.Add(FindParameterIndex(ParameterName));
+	}
+}
+
+bool UGTSceneComponent::SetVectorParameterValue(int32 ParameterIndex, const FLinearColor& ParameterValue)
+{
+	if (ParameterIndex != INDEX_NONE && ParameterCollectionBuffer.IsValid())
+	{
+		ParameterCollectionBuffer->SetVectorParameterValue(ParameterIndex, ParameterValue);
+		return true;
 	}
 
 	return false;
@@ -144,48 +191,85 @@ void UGTSceneComponent::AddToWorldParameterCollection()
 {
 	if (IsValid())
 	{
-		if (HasParameterCollectionOverride())
+		if (!HasParameterCollectionOverride() && WorldSlotIndex == INDEX_NONE)
 		{
-			UpdateParameterCollection();
+			WorldSlotIndex = GetWorldComponents().Add(this);
 		}
-		else
-		{
-			TArray<UGTSceneComponent*>& Components = GetWorldComponents();
 
-			if (Components.Find(this) == INDEX_NONE)
-			{
-				Components.Add(this);
-				UpdateParameterCollection();
-			}
-		}
+		MarkParameterCollectionDirty();
 	}
 }
 
 void UGTSceneComponent::RemoveFromWorldParameterCollection()
 {
-	if (IsValid())
+	// Pending updates must not re-enable a component after it has been removed.
+	if (WorldSubsystem != nullptr)
 	{
-		if (HasParameterCollectionOverride())
+		WorldSubsystem->ClearComponentDirty(this);
+	}
+
+	if (WorldSlotIndex != INDEX_NONE && WorldSubsystem != nullptr)
+	{
+		// Disable the slot this component occupies.
+		if (IsValid())
 		{
 			UpdateParameterCollection(true);
 		}
-		else
+
+		// Only a component which was moved into the freed slot needs to be re-uploaded.
+		if (UGTSceneComponent* MovedComponent = GetWorldComponents().Remove(WorldSlotIndex, GetNumActiveWorldSlots()))
 		{
-			TArray<UGTSceneComponent*>& Components = GetWorldComponents();
-			const int32 ComponentIndex = Components.Find(this);
+			MovedComponent->WorldSlotIndex = WorldSlotIndex;
+			MovedComponent->MarkParameterCollectionDirty();
+		}
+	}
+	else if (HasParameterCollectionOverride() && IsValid())
+	{
+		UpdateParameterCollection(true);
+	}
 
-			if (ComponentIndex != INDEX_NONE)
-			{
-				// Disable the last component.
-				Components[Components.Num() - 1]->UpdateParameterCollection(true);
+	WorldSlotIndex = INDEX_NONE;
+}
 
-				Components.RemoveAt(ComponentIndex);
+void UGTSceneComponent::MarkParameterCollectionDirty()
+{
+	if (IsValid())
+	{
+		WorldSubsystem->MarkComponentDirty(this);
+	}
+}
 
-				for (auto Component : Components)
-				{
-					Component->UpdateParameterCollection();
-				}
-			}
-		}
+void UGTSceneComponent::MarkParameterCollectionTransformDirty()
+{
+	// Components which are not writing to a parameter collection (hidden components) have nothing to update.
+	if (IsValid() && (WorldSlotIndex != INDEX_NONE || HasParameterCollectionOverride()))
+	{
+		WorldSubsystem->MarkComponentTransformDirty(this);
+	}
+}
+
+void UGTSceneComponent::CacheParameterCollection()
+{
+	ParameterCollectionBuffer.Reset();
+
+	if (WorldSubsystem != nullptr)
+	{
+		ParameterCollectionBuffer = WorldSubsystem->FindOrAddParameterCollectionBuffer(GetParameterCollection());
+	}
+
+	if (ParameterCollectionBuffer.IsValid())
+	{
+		ParameterCollectionBufferVersion = ParameterCollectionBuffer->GetVersion();
+	}
+
+	CacheParameterIndices();
+}
+
+void UGTSceneComponent::ValidateParameterCache()
+{
+	if (ParameterCollectionBuffer.IsValid() && ParameterCollectionBuffer->GetVersion() != ParameterCollectionBufferVersion)
+	{
+		ParameterCollectionBufferVersion = ParameterCollectionBuffer->GetVersion();
+		CacheParameterIndices();
 	}
 }
@@ -0,0 +1,21 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "GTSceneViewExtension.h"
+
+#include "GTDataTexture.h"
+
+FGTSceneViewExtension::FGTSceneViewExtension(
+	const FAutoRegister& AutoRegister, UWorld* InWorld, const TSharedPtr<FGTDataTexture>& InDataTexture)
+	: FWorldSceneViewExtension(AutoRegister, InWorld)
+	, DataTexture(InDataTexture)
+{
+}
+
+void FGTSceneViewExtension::BeginRenderViewFamily(FSceneViewFamily& InViewFamily)
+{
+	if (TSharedPtr<FGTDataTexture> PinnedDataTexture = DataTexture.Pin())
+	{
+		PinnedDataTexture->Submit();
+	}
+}
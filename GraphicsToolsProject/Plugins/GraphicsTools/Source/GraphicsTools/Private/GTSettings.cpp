@@ -0,0 +1,10 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "GTSettings.h"
+
+UGTSettings::UGTSettings()
+{
+	CategoryName = TEXT("Plugins");
+	SectionName = TEXT("Graphics Tools");
+}
@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "GTSurfaceGrid.h"
+
+namespace GTSurfaceGrid
+{
+	/** Surfaces, or queries, which overlap more cells than this bypass the cells. */
+	constexpr int32 MaxCells = 64;
+
+	int64 NumCells(const FIntVector& Min, const FIntVector& Max)
+	{
+		return static_cast<int64>(Max.X - Min.X + 1) * (Max.Y - Min.Y + 1) * (Max.Z - Min.Z + 1);
+	}
+} // namespace GTSurfaceGrid
+
+void FGTSurfaceGrid::Reset(float InCellSize)
+{
+	Surfaces.Reset();
+	Cells.Reset();
+	LargeSurfaces.Reset();
+	CellSize = FMath::Max(InCellSize, 1.0f);
+}
+
+void FGTSurfaceGrid::Add(const FBox& Bounds)
+{
+	const int32 SurfaceIndex = Surfaces.Add(Bounds);
+
+	FIntVector Min, Max;
+	CalculateCellRange(Bounds, Min, Max);
+
+	if (GTSurfaceGrid::NumCells(Min, Max) > GTSurfaceGrid::MaxCells)
+	{
+		LargeSurfaces.Add(SurfaceIndex);
+		return;
+	}
+
+	for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			for (int32 X = Min.X; X <= Max.X; ++X)
+			{
+				Cells.FindOrAdd(FIntVector(X, Y, Z)).Add(SurfaceIndex);
+			}
+		}
+	}
+}
+
+bool FGTSurfaceGrid::Intersects(const FSphere& Sphere) const
+{
+	if (Surfaces.Num() == 0)
+	{
+		return false;
+	}
+
+	FIntVector Min, Max;
+	CalculateCellRange(FBox(Sphere.Center - Sphere.W, Sphere.Center + Sphere.W), Min, Max);
+
+	// Large queries visit fewer surfaces by testing every surface than by visiting every cell.
+	if (GTSurfaceGrid::NumCells(Min, Max) > GTSurfaceGrid::MaxCells)
+	{
+		for (const FBox& Bounds : Surfaces)
+		{
+			if (FMath::SphereAABBIntersection(Sphere, Bounds))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	for (int32 SurfaceIndex : LargeSurfaces)
+	{
+		if (FMath::SphereAABBIntersection(Sphere, Surfaces[SurfaceIndex]))
+		{
+			return true;
+		}
+	}
+
+	for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			for (int32 X = Min.X; X <= Max.X; ++X)
+			{
+				if (const TArray<int32>* Cell = Cells.Find(FIntVector(X, Y, Z)))
+				{
+					for (int32 SurfaceIndex : *Cell)
+					{
+						if (FMath::SphereAABBIntersection(Sphere, Surfaces[SurfaceIndex]))
+						{
+							return true;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+void FGTSurfaceGrid::CalculateCellRange(const FBox& Bounds, FIntVector& Min, FIntVector& Max) const
+{
+	const FVector LocalMin = Bounds.Min / CellSize;
+	const FVector LocalMax = Bounds.Max / CellSize;
+
+	Min = FIntVector(FMath::FloorToInt(LocalMin.X), FMath::FloorToInt(LocalMin.Y), FMath::FloorToInt(LocalMin.Z));
+	Max = FIntVector(FMath::FloorToInt(LocalMax.X), FMath::FloorToInt(LocalMax.Y), FMath::FloorToInt(LocalMax.Z));
+}
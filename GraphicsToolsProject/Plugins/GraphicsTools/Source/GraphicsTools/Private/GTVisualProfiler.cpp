@@ -151,6 +151,8 @@ AGTVisualProfiler::AGTVisualProfiler()
 
 void AGTVisualProfiler::Tick(float DeltaTime)
 {
+	GT_SCOPE_CYCLE_COUNTER(STAT_GTVisualProfilerTick);
+
 	Super::Tick(DeltaTime);
 
 	if (RootComponent->IsActive() && RootComponent->IsVisible())
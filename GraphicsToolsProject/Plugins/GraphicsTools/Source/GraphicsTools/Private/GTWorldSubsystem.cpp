@@ -3,7 +3,898 @@
 
 #include "GTWorldSubsystem.h"
 
+#include "GTClippingCullingComponent.h"
+#include "GTClippingPrimitiveComponent.h"
+#include "GTDataTexture.h"
+#include "GTDirectionalLightComponent.h"
+#include "GTParameterCollectionBuffer.h"
+#include "GTProximityLightComponent.h"
+#include "GTProximityLightSurfaceComponent.h"
+#include "GTSceneComponent.h"
+#include "GTSceneViewExtension.h"
+#include "GTSettings.h"
+#include "GraphicsTools.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Features/IModularFeatures.h"
+#include "IHandTracker.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+TRACE_DECLARE_INT_COUNTER(GTParameterWrites, TEXT("GraphicsTools/MPC Writes"));
+TRACE_DECLARE_INT_COUNTER(GTSkippedParameterWrites, TEXT("GraphicsTools/MPC Skipped Writes"));
+TRACE_DECLARE_INT_COUNTER(GTSkippedTransformUpdates, TEXT("GraphicsTools/Skipped Transform Updates"));
+
+static TAutoConsoleVariable<float> CVarProximityLightHysteresis(
+	TEXT("GraphicsTools.ProximityLightHysteresis"), 1.25f,
+	TEXT("Relevance multiplier applied to proximity lights which are already selected. A light must be this much more relevant than a ")
+		TEXT("selected light to take its slot, which stops lights of similar relevance from flickering."));
+
+namespace GTWorldSubsystem
+{
+	/** The packed texels of a directional light and its color premultiplied by intensity. */
+	struct FDirectionalLightSample
+	{
+		FLinearColor Data[2];
+		FLinearColor Radiance;
+	};
+
+	/** Collapses directional lights into a single dominant light, written as a direction and enabled state texel and a color and intensity
+	 * texel, followed by an ambient color texel. */
+	void CollapseDirectionalLights(TArrayView<const FDirectionalLightSample> Lights, FLinearColor* Data)
+	{
+		FVector Direction = FVector::ZeroVector;
+		FLinearColor Radiance = FLinearColor::Black;
+		float Weight = 0;
+
+		for (const FDirectionalLightSample& Light : Lights)
+		{
+			const float Luminance = Light.Radiance.GetLuminance();
+			Direction += FVector(Light.Data[0].R, Light.Data[0].G, Light.Data[0].B) * Luminance;
+			Radiance += Light.Radiance;
+			Weight += Luminance;
+		}
+
+		if (Weight <= 0)
+		{
+			return;
+		}
+
+		// The weighted directions only sum to the total weight when every light shares a direction. The portion which cancels out lights
+		// surfaces from every side, so it becomes ambient light scaled by the average (clamped) cosine over the sphere.
+		const float Alignment = FMath::Clamp(static_cast<float>(Direction.Size()) / Weight, 0.0f, 1.0f);
+
+		Data[0] = FLinearColor(Direction.GetSafeNormal());
+		Data[0].A = 1;
+		Data[1] = Radiance * Alignment;
+		Data[1].A = 1;
+		Data[2] = Radiance * ((1 - Alignment) * 0.25f);
+		Data[2].A = 0;
+	}
+
+#if COUNTERSTRACE_ENABLED
+	/** Trace counters are global, so the counts of every world flushed within a frame are summed before they are traced. */
+	struct FTraceCounts
+	{
+		uint64 Frame = 0;
+		int64 ParameterWrites = 0;
+		int64 SkippedParameterWrites = 0;
+		int64 SkippedTransformUpdates = 0;
+	};
+
+	FTraceCounts TraceCounts;
+#endif // COUNTERSTRACE_ENABLED
+} // namespace GTWorldSubsystem
+
+void UGTWorldSubsystem::MarkComponentDirty(UGTSceneComponent* Component)
+{
+	DirtyComponents.Add(Component);
+}
+
+void UGTWorldSubsystem::MarkComponentTransformDirty(UGTSceneComponent* Component)
+{
+	DirtyTransformComponents.Add(Component);
+}
+
+void UGTWorldSubsystem::ClearComponentDirty(UGTSceneComponent* Component)
+{
+	DirtyComponents.Remove(Component);
+	DirtyTransformComponents.Remove(Component);
+}
+
+void UGTWorldSubsystem::FlushDirtyComponents()
+{
+	GT_SCOPE_CYCLE_COUNTER(STAT_GTFlushDirtyComponents);
+
+#if WITH_EDITOR
+	RebuildStaleParameterCollectionBuffers();
+#endif // WITH_EDITOR
+
+	UpdateProximityLightSurfaces();
+	SelectProximityLights();
+
+	NumSkippedTransformUpdates = 0;
+
+	for (UGTSceneComponent* Component : DirtyComponents)
+	{
+		Component->ValidateParameterCache();
+		Component->UpdateParameterCollection();
+	}
+
+	for (UGTSceneComponent* Component : DirtyTransformComponents)
+	{
+		// A full update already includes the transform.
+		if (!DirtyComponents.Contains(Component))
+		{
+			Component->ValidateParameterCache();
+			Component->UpdateParameterCollectionTransform();
+		}
+	}
+
+	for (UGTProximityLightComponent* Light : PulsedProximityLights)
+	{
+		// A full update already includes the pulse.
+		if (!DirtyComponents.Contains(Light))
+		{
+			Light->ValidateParameterCache();
+			Light->UpdateParameterCollectionPulse();
+		}
+	}
+
+	DirtyComponents.Reset();
+	DirtyTransformComponents.Reset();
+	PulsedProximityLights.Reset();
+
+	if (DataTexture.IsValid() && GetDefault<UGTSettings>()->bEnableProximityLightClusters && !CalculateClusterOrigin().Equals(ClusterOrigin))
+	{
+		// The view moved into a new cell.
+		bDataTextureDirty = true;
+	}
+
+	if (DataTexture.IsValid() && bDataTextureDirty)
+	{
+		UpdateDataTexture();
+		bDataTextureDirty = false;
+	}
+
+	NumParameterWrites = 0;
+	NumSkippedParameterWrites = 0;
+
+	{
+		GT_SCOPE_CYCLE_COUNTER(STAT_GTFlushParameterCollections);
+
+		for (auto& Pair : ParameterCollectionBuffers)
+		{
+			Pair.Value->Flush();
+			NumParameterWrites += Pair.Value->GetNumWrites();
+			NumSkippedParameterWrites += Pair.Value->GetNumSkippedWrites();
+		}
+	}
+
+	UpdateStats();
+}
+
+UTexture2D* UGTWorldSubsystem::GetDataTexture() const
+{
+	return DataTexture.IsValid() ? DataTexture->GetTexture() : nullptr;
+}
+
+void UGTWorldSubsystem::BindDataTexture(UMaterialInstanceDynamic* Material)
+{
+	static const FName ParameterName("GTDataTexture");
+
+	if (Material != nullptr && DataTexture.IsValid())
+	{
+		Material->SetTextureParameterValue(ParameterName, DataTexture->GetTexture());
+		DataTextureMaterials.AddUnique(Material);
+	}
+}
+
+void UGTWorldSubsystem::AddClippingCullingComponent(UGTClippingCullingComponent* Component)
+{
+	ClippingCullingComponents.AddUnique(Component);
+}
+
+void UGTWorldSubsystem::RemoveClippingCullingComponent(UGTClippingCullingComponent* Component)
+{
+	ClippingCullingComponents.RemoveSingleSwap(Component, false);
+}
+
+void UGTWorldSubsystem::ReleaseProximityLightSlot(UGTProximityLightComponent* Light)
+{
+	if (ProximityLightSlots.IsValidIndex(Light->ParameterCollectionSlot))
+	{
+		ProximityLightSlots[Light->ParameterCollectionSlot] = nullptr;
+	}
+
+	Light->ParameterCollectionSlot = INDEX_NONE;
+}
+
+void UGTWorldSubsystem::StartProximityLightPulse(UGTProximityLightComponent* Light, float Duration, float FadeOffset, float FadeDuration)
+{
+	ProximityLightPulses.Add(Light, Duration, FadeOffset, FadeDuration);
+}
+
+void UGTWorldSubsystem::StopProximityLightPulse(UGTProximityLightComponent* Light)
+{
+	ProximityLightPulses.Remove(Light);
+	PulsedProximityLights.RemoveSwap(Light);
+}
+
+void UGTWorldSubsystem::AddHandJointLight(UGTProximityLightComponent* Light)
+{
+	HandJointLights.AddUnique(Light);
+}
+
+void UGTWorldSubsystem::RemoveHandJointLight(UGTProximityLightComponent* Light)
+{
+	HandJointLights.RemoveSwap(Light);
+}
+
+void UGTWorldSubsystem::AddProximityLightSurface(UGTProximityLightSurfaceComponent* Surface)
+{
+	ProximityLightSurfaces.AddUnique(Surface);
+}
+
+void UGTWorldSubsystem::RemoveProximityLightSurface(UGTProximityLightSurfaceComponent* Surface)
+{
+	ProximityLightSurfaces.RemoveSwap(Surface);
+}
+
+TSharedPtr<FGTParameterCollectionBuffer> UGTWorldSubsystem::FindOrAddParameterCollectionBuffer(
+	const UMaterialParameterCollection* Collection)
+{
+	if (Collection == nullptr)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FGTParameterCollectionBuffer>& Buffer = ParameterCollectionBuffers.FindOrAdd(TObjectKey<UMaterialParameterCollection>(Collection));
+
+	if (!Buffer.IsValid())
+	{
+		Buffer = MakeShared<FGTParameterCollectionBuffer>(GetWorld(), Collection);
+	}
+
+	return Buffer;
+}
+
+void UGTWorldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	ProximityLightSlots.SetNumZeroed(GT_MAX_PROXIMITY_LIGHTS);
+
+	if (GetDefault<UGTSettings>()->bEnableDataTexture)
+	{
+		DataTexture = MakeShared<FGTDataTexture>();
+		SceneViewExtension = FSceneViewExtensions::NewExtension<FGTSceneViewExtension>(GetWorld(), DataTexture);
+		UpdateDataTexture();
+	}
+}
+
+void UGTWorldSubsystem::Deinitialize()
+{
+	DirtyComponents.Empty();
+	DirtyTransformComponents.Empty();
+	ProximityLightSlots.Empty();
+	ProximityLightCandidates.Empty();
+	PulsedProximityLights.Empty();
+	HandJointLights.Empty();
+	ProximityLightSurfaces.Empty();
+	ClippingCullingComponents.Empty();
+	SceneViewExtension.Reset();
+	DataTexture.Reset();
+	DataTextureMaterials.Empty();
+	ParameterCollectionBuffers.Empty();
+
+	Super::Deinitialize();
+}
+
 bool UGTWorldSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
 {
 	return (UWorldSubsystem::DoesSupportWorldType(WorldType) || WorldType == EWorldType::EditorPreview);
 }
+
+void UGTWorldSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UpdateHandJointLights();
+	UpdateProximityLightPulses(DeltaTime);
+	FlushDirtyComponents();
+	UpdateClippingCulling();
+}
+
+void UGTWorldSubsystem::UpdateHandJointLights()
+{
+	// Hand tracking is only available at runtime, and moving lights within an editor world would modify the level.
+	if (HandJointLights.Num() == 0 || !GetWorld()->IsGameWorld())
+	{
+		return;
+	}
+
+	GT_SCOPE_CYCLE_COUNTER(STAT_GTUpdateHandJointLights);
+
+	// Use the first hand tracker which is currently tracking, such as the OpenXR hand tracker or FGTFakeHandTracker.
+	const IHandTracker* HandTracker = nullptr;
+	const FName FeatureName = IHandTracker::GetModularFeatureName();
+
+	for (IHandTracker* Implementation : IModularFeatures::Get().GetModularFeatureImplementations<IHandTracker>(FeatureName))
+	{
+		if (Implementation->IsHandTrackingStateValid())
+		{
+			HandTracker = Implementation;
+			break;
+		}
+	}
+
+	const double Time = FPlatformTime::Seconds();
+
+	for (UGTProximityLightComponent* Light : HandJointLights)
+	{
+		Light->UpdateHandJoint(HandTracker, Time);
+	}
+}
+
+void UGTWorldSubsystem::UpdateProximityLightPulses(float DeltaTime)
+{
+	GT_SCOPE_CYCLE_COUNTER(STAT_GTUpdateProximityLightPulses);
+
+	// Pulses previously animated within component ticks, which do not tick while paused or within editor worlds.
+	if (ProximityLightPulses.Num() != 0 && GetWorld()->IsGameWorld() && !GetWorld()->IsPaused())
+	{
+		ProximityLightPulses.Update(DeltaTime, PulsedProximityLights);
+	}
+}
+
+void UGTWorldSubsystem::UpdateProximityLightSurfaces()
+{
+	NumProximityLightsAwayFromSurfaces = 0;
+
+	const bool AnyLightNeedsSurfaces = ProximityLights.GetSlots().ContainsByPredicate(
+		[](const UGTSceneComponent* Component)
+		{ return Component != nullptr && static_cast<const UGTProximityLightComponent*>(Component)->bDisableAwayFromSurfaces; });
+
+	// Surfaces are only known through UGTProximityLightSurfaceComponent markers, without any every light is treated as near a surface
+	// rather than disabling lights in levels which never opted in.
+	const bool AnySurfaces = ProximityLightSurfaces.Num() > 0;
+
+	if (AnyLightNeedsSurfaces && !AnySurfaces && !bWarnedNoProximityLightSurfaces)
+	{
+		UE_LOG(
+			GraphicsTools, Warning,
+			TEXT("Proximity lights with DisableAwayFromSurfaces are never disabled because no GTProximityLightSurface component is ")
+				TEXT("registered in world %s."),
+			*GetWorld()->GetName());
+		bWarnedNoProximityLightSurfaces = true;
+	}
+
+	if (AnyLightNeedsSurfaces && AnySurfaces)
+	{
+		GT_SCOPE_CYCLE_COUNTER(STAT_GTUpdateProximityLightSurfaces);
+
+		// Surfaces and lights both move freely, rebuilding the grid is cheaper than tracking which surfaces moved.
+		SurfaceGrid.Reset(GetDefault<UGTSettings>()->ProximityLightSurfaceCellSize);
+
+		for (const UGTProximityLightSurfaceComponent* Surface : ProximityLightSurfaces)
+		{
+			for (const TWeakObjectPtr<UPrimitiveComponent>& Primitive : Surface->GetPrimitives())
+			{
+				if (Primitive.IsValid() && Primitive->IsRegistered() && Primitive->IsVisible())
+				{
+					SurfaceGrid.Add(Primitive->Bounds.GetBox());
+				}
+			}
+		}
+	}
+
+	for (UGTSceneComponent* Component : ProximityLights.GetSlots())
+	{
+		if (Component != nullptr)
+		{
+			UGTProximityLightComponent* Light = static_cast<UGTProximityLightComponent*>(Component);
+			const bool NearSurface =
+				!Light->bDisableAwayFromSurfaces || !AnySurfaces ||
+				SurfaceGrid.Intersects(FSphere(Light->GetComponentLocation(), Light->GetInfluenceRadius()));
+
+			if (Light->bNearSurface != NearSurface)
+			{
+				Light->bNearSurface = NearSurface;
+
+				// Lights away from surfaces are not packed.
+				bDataTextureDirty = true;
+			}
+
+			NumProximityLightsAwayFromSurfaces += !NearSurface;
+		}
+	}
+}
+
+void UGTWorldSubsystem::SelectProximityLights()
+{
+	GT_SCOPE_CYCLE_COUNTER(STAT_GTSelectProximityLights);
+
+	ProximityLightCandidates.Reset();
+
+	for (UGTSceneComponent* Component : ProximityLights.GetSlots())
+	{
+		if (Component != nullptr && static_cast<UGTProximityLightComponent*>(Component)->bNearSurface)
+		{
+			ProximityLightCandidates.Emplace(static_cast<UGTProximityLightComponent*>(Component), 0.0f);
+		}
+	}
+
+	// When every light fits all of them are selected, otherwise only the most relevant lights are.
+	if (ProximityLightCandidates.Num() > GT_MAX_PROXIMITY_LIGHTS)
+	{
+		const TArray<FVector>& ViewLocations = GetWorld()->ViewLocationsRenderedLastFrame;
+		const float Hysteresis = CVarProximityLightHysteresis.GetValueOnGameThread();
+
+		for (TPair<UGTProximityLightComponent*, float>& Candidate : ProximityLightCandidates)
+		{
+			Candidate.Value = Candidate.Key->CalculateRelevance(ViewLocations);
+
+			if (Candidate.Key->ParameterCollectionSlot != INDEX_NONE)
+			{
+				Candidate.Value *= Hysteresis;
+			}
+		}
+
+		// Partially sort so only the most relevant lights are at the front.
+		for (int32 Index = 0; Index < GT_MAX_PROXIMITY_LIGHTS; ++Index)
+		{
+			int32 MostRelevantIndex = Index;
+
+			for (int32 CandidateIndex = Index + 1; CandidateIndex < ProximityLightCandidates.Num(); ++CandidateIndex)
+			{
+				if (ProximityLightCandidates[CandidateIndex].Value > ProximityLightCandidates[MostRelevantIndex].Value)
+				{
+					MostRelevantIndex = CandidateIndex;
+				}
+			}
+
+			ProximityLightCandidates.Swap(Index, MostRelevantIndex);
+		}
+
+		ProximityLightCandidates.SetNum(GT_MAX_PROXIMITY_LIGHTS, false);
+	}
+
+	// Disable and release the slots of lights which are no longer selected.
+	for (UGTProximityLightComponent*& Light : ProximityLightSlots)
+	{
+		if (Light != nullptr &&
+			!ProximityLightCandidates.ContainsByPredicate([Light](const TPair<UGTProximityLightComponent*, float>& Candidate)
+														  { return Candidate.Key == Light; }))
+		{
+			Light->UpdateParameterCollection(true);
+			Light->ParameterCollectionSlot = INDEX_NONE;
+			Light = nullptr;
+		}
+	}
+
+	// Assign free slots to newly selected lights.
+	for (const TPair<UGTProximityLightComponent*, float>& Candidate : ProximityLightCandidates)
+	{
+		UGTProximityLightComponent* Light = Candidate.Key;
+
+		if (Light->ParameterCollectionSlot == INDEX_NONE)
+		{
+			Light->ParameterCollectionSlot = ProximityLightSlots.Find(nullptr);
+			check(Light->ParameterCollectionSlot != INDEX_NONE);
+			ProximityLightSlots[Light->ParameterCollectionSlot] = Light;
+			DirtyComponents.Add(Light);
+		}
+	}
+}
+
+void UGTWorldSubsystem::UpdateClippingCulling()
+{
+	GT_SCOPE_CYCLE_COUNTER(STAT_GTUpdateClippingCulling);
+
+	// Spread the cost of culling across frames, each component is updated once every few frames when there are many components.
+	const int32 NumUpdates = FMath::Min(GetDefault<UGTSettings>()->ClippingCullingComponentsPerFrame, ClippingCullingComponents.Num());
+
+	for (int32 UpdateIndex = 0; UpdateIndex < NumUpdates; ++UpdateIndex)
+	{
+		if (ClippingCullingIndex >= ClippingCullingComponents.Num())
+		{
+			ClippingCullingIndex = 0;
+		}
+
+		ClippingCullingComponents[ClippingCullingIndex++]->UpdateCulling();
+	}
+}
+
+void UGTWorldSubsystem::UpdateDataTexture()
+{
+	GT_SCOPE_CYCLE_COUNTER(STAT_GTUpdateDataTexture);
+
+	const UGTSettings* Settings = GetDefault<UGTSettings>();
+	const int32 MaxProximityLights = Settings->MaxDataTextureProximityLights;
+	const int32 MaxClippingPrimitives = Settings->MaxDataTextureClippingPrimitives;
+	const int32 ClippingPrimitiveTexels =
+		MaxClippingPrimitives * (GT_DATA_TEXTURE_CLIPPING_PLANE_TEXELS + GT_DATA_TEXTURE_CLIPPING_SPHERE_TEXELS +
+								 GT_DATA_TEXTURE_CLIPPING_BOX_TEXELS + GT_DATA_TEXTURE_CLIPPING_CONE_TEXELS);
+	int32 NumTexels = GT_DATA_TEXTURE_HEADER_TEXELS + (MaxProximityLights * GT_DATA_TEXTURE_PROXIMITY_LIGHT_TEXELS) +
+					  ClippingPrimitiveTexels + GT_DATA_TEXTURE_DIRECTIONAL_LIGHT_TEXELS;
+
+	if (Settings->bEnableProximityLightClusters)
+	{
+		NumTexels += FMath::Cube(Settings->ProximityLightClusterGridSize) + FMath::DivideAndRoundUp(Settings->MaxProximityLightClusterIndices, 4);
+	}
+
+	UTexture2D* PreviousTexture = DataTexture->GetTexture();
+	DataTexture->Reset(NumTexels);
+	ProximityLightBounds.Reset();
+
+	// Changing the data texture settings can recreate the texture, so point every bound material at the new texture.
+	if (DataTexture->GetTexture() != PreviousTexture)
+	{
+		TArray<TWeakObjectPtr<UMaterialInstanceDynamic>> Materials = MoveTemp(DataTextureMaterials);
+
+		for (const TWeakObjectPtr<UMaterialInstanceDynamic>& Material : Materials)
+		{
+			BindDataTexture(Material.Get());
+		}
+	}
+
+	int32 TexelIndex = GT_DATA_TEXTURE_HEADER_TEXELS;
+
+	for (UGTSceneComponent* Component : ProximityLights.GetSlots())
+	{
+		// Lights away from surfaces are skipped, leaving room for lights which can be seen.
+		if (Component != nullptr && static_cast<UGTProximityLightComponent*>(Component)->bNearSurface &&
+			ProximityLightBounds.Num() < MaxProximityLights)
+		{
+			const UGTProximityLightComponent* Light = static_cast<UGTProximityLightComponent*>(Component);
+			Light->PackLightData(&(*DataTexture)[TexelIndex]);
+
+			if (Light->bFollowHandJoint && Light->bHandJointTracked)
+			{
+				DataTexture->AddLocationPrediction(
+					TexelIndex, Light->HandJointLocation, Light->HandJointVelocity, Light->HandJointSampleTime,
+					Light->HandJointPredictionTime);
+
+				// The render thread may move the light up to MaxPredictionTime along its velocity, grow the bounds to cover it.
+				ProximityLightBounds.Emplace(
+					Light->HandJointLocation,
+					Light->GetInfluenceRadius() + (Light->HandJointVelocity.Size() * FGTDataTexture::MaxPredictionTime));
+			}
+			else
+			{
+				ProximityLightBounds.Emplace(Light->GetComponentLocation(), Light->GetInfluenceRadius());
+			}
+
+			TexelIndex += GT_DATA_TEXTURE_PROXIMITY_LIGHT_TEXELS;
+		}
+	}
+
+	(*DataTexture)[GT_DATA_TEXTURE_PROXIMITY_LIGHT_HEADER] =
+		FLinearColor(ProximityLightBounds.Num(), GT_DATA_TEXTURE_HEADER_TEXELS, 0, 0);
+	(*DataTexture)[GT_DATA_TEXTURE_PROXIMITY_LIGHT_BOUNDS_HEADER] = CalculateProximityLightSetBounds();
+
+	TexelIndex = GT_DATA_TEXTURE_HEADER_TEXELS + (MaxProximityLights * GT_DATA_TEXTURE_PROXIMITY_LIGHT_TEXELS);
+	TexelIndex = PackClippingPrimitives(ClippingPlanes, GT_DATA_TEXTURE_CLIPPING_PLANE_HEADER, GT_DATA_TEXTURE_CLIPPING_PLANE_TEXELS, TexelIndex);
+	TexelIndex =
+		PackClippingPrimitives(ClippingSpheres, GT_DATA_TEXTURE_CLIPPING_SPHERE_HEADER, GT_DATA_TEXTURE_CLIPPING_SPHERE_TEXELS, TexelIndex);
+	TexelIndex = PackClippingPrimitives(ClippingBoxes, GT_DATA_TEXTURE_CLIPPING_BOX_HEADER, GT_DATA_TEXTURE_CLIPPING_BOX_TEXELS, TexelIndex);
+	TexelIndex = PackClippingPrimitives(ClippingCones, GT_DATA_TEXTURE_CLIPPING_CONE_HEADER, GT_DATA_TEXTURE_CLIPPING_CONE_TEXELS, TexelIndex);
+	TexelIndex = PackDirectionalLights(TexelIndex);
+
+	if (Settings->bEnableProximityLightClusters)
+	{
+		PackProximityLightClusters(TexelIndex);
+	}
+
+	DataTexture->Upload();
+}
+
+FLinearColor UGTWorldSubsystem::CalculateProximityLightSetBounds() const
+{
+	if (ProximityLightBounds.Num() == 0)
+	{
+		return FLinearColor(0, 0, 0, 0);
+	}
+
+	// Center the sphere on the box around every light's influence, then grow it until each light's influence is enclosed.
+	FBox Box(ForceInit);
+
+	for (const FSphere& Bounds : ProximityLightBounds)
+	{
+		Box += FBox(Bounds.Center - Bounds.W, Bounds.Center + Bounds.W);
+	}
+
+	const FVector Center = Box.GetCenter();
+	double Radius = 0;
+
+	for (const FSphere& Bounds : ProximityLightBounds)
+	{
+		Radius = FMath::Max(Radius, FVector::Dist(Center, Bounds.Center) + Bounds.W);
+	}
+
+	return FLinearColor(Center.X, Center.Y, Center.Z, Radius);
+}
+
+int32 UGTWorldSubsystem::PackClippingPrimitives(
+	const FGTComponentSlots& Primitives, int32 HeaderIndex, int32 TexelsPerPrimitive, int32 TexelIndex)
+{
+	const UGTSettings* Settings = GetDefault<UGTSettings>();
+	const int32 MaxPrimitives = Settings->MaxDataTextureClippingPrimitives;
+	const float CombineMode = Settings->ClippingPrimitiveCombineMode == EGTClippingPrimitiveCombineMode::Intersection ? 1 : 0;
+	int32 NumPrimitives = 0;
+
+	for (UGTSceneComponent* Component : Primitives.GetSlots())
+	{
+		if (Component != nullptr && NumPrimitives < MaxPrimitives)
+		{
+			static_cast<UGTClippingPrimitiveComponent*>(Component)->PackPrimitiveData(
+				&(*DataTexture)[TexelIndex + (NumPrimitives * TexelsPerPrimitive)]);
+			++NumPrimitives;
+		}
+	}
+
+	(*DataTexture)[HeaderIndex] = FLinearColor(NumPrimitives, TexelIndex, CombineMode, 0);
+
+	return TexelIndex + (MaxPrimitives * TexelsPerPrimitive);
+}
+
+int32 UGTWorldSubsystem::PackDirectionalLights(int32 TexelIndex)
+{
+	TArray<GTWorldSubsystem::FDirectionalLightSample, TInlineAllocator<8>> Lights;
+
+	for (UGTSceneComponent* Component : DirectionalLights.GetSlots())
+	{
+		if (Component != nullptr)
+		{
+			GTWorldSubsystem::FDirectionalLightSample& Light = Lights.AddDefaulted_GetRef();
+			static_cast<UGTDirectionalLightComponent*>(Component)->PackLightData(Light.Data);
+			Light.Radiance = Light.Data[1] * Light.Data[1].A;
+		}
+	}
+
+	// The strongest lights are evaluated with specular, so they are packed first.
+	Lights.Sort([](const GTWorldSubsystem::FDirectionalLightSample& A, const GTWorldSubsystem::FDirectionalLightSample& B)
+				{ return A.Radiance.GetLuminance() > B.Radiance.GetLuminance(); });
+
+	// Unused texels remain cleared, which disables them.
+	FLinearColor* Data = &(*DataTexture)[TexelIndex];
+	const int32 NumFullLights = FMath::Min(Lights.Num(), 2);
+
+	for (int32 LightIndex = 0; LightIndex < NumFullLights; ++LightIndex)
+	{
+		Data[(LightIndex * 2) + 0] = Lights[LightIndex].Data[0];
+		Data[(LightIndex * 2) + 1] = Lights[LightIndex].Data[1];
+	}
+
+	if (Lights.Num() > NumFullLights)
+	{
+		const TArrayView<const GTWorldSubsystem::FDirectionalLightSample> AllLights(Lights);
+		GTWorldSubsystem::CollapseDirectionalLights(AllLights.Slice(NumFullLights, Lights.Num() - NumFullLights), &Data[4]);
+	}
+
+	GTWorldSubsystem::CollapseDirectionalLights(Lights, &Data[7]);
+
+	(*DataTexture)[GT_DATA_TEXTURE_DIRECTIONAL_LIGHT_HEADER] = FLinearColor(Lights.Num(), TexelIndex, 0, 0);
+
+	return TexelIndex + GT_DATA_TEXTURE_DIRECTIONAL_LIGHT_TEXELS;
+}
+
+void UGTWorldSubsystem::PackProximityLightClusters(int32 TexelIndex)
+{
+	const UGTSettings* Settings = GetDefault<UGTSettings>();
+	const int32 GridSize = Settings->ProximityLightClusterGridSize;
+	const int32 NumClusters = FMath::Cube(GridSize);
+	const int32 MaxIndices = Settings->MaxProximityLightClusterIndices;
+	const float ClusterSize = Settings->ProximityLightClusterSize;
+	const int32 ClusterTexelIndex = TexelIndex;
+	const int32 IndexTexelIndex = ClusterTexelIndex + NumClusters;
+
+	ClusterOrigin = CalculateClusterOrigin();
+
+	(*DataTexture)[GT_DATA_TEXTURE_PROXIMITY_LIGHT_CLUSTER_HEADER] =
+		FLinearColor(ClusterOrigin.X, ClusterOrigin.Y, ClusterOrigin.Z, ClusterSize);
+	(*DataTexture)[GT_DATA_TEXTURE_PROXIMITY_LIGHT_CLUSTER_HEADER + 1] = FLinearColor(GridSize, ClusterTexelIndex, IndexTexelIndex, 0);
+
+	// Calculates the range of clusters a light overlaps, returns false if the light is outside of the grid.
+	auto CalculateClusterRange = [&](const FSphere& Bounds, FIntVector& Min, FIntVector& Max)
+	{
+		const FVector LocalCenter = (Bounds.Center - ClusterOrigin) / ClusterSize;
+		const float LocalRadius = Bounds.W / ClusterSize;
+
+		Min = FIntVector(
+			FMath::FloorToInt(LocalCenter.X - LocalRadius), FMath::FloorToInt(LocalCenter.Y - LocalRadius),
+			FMath::FloorToInt(LocalCenter.Z - LocalRadius));
+		Max = FIntVector(
+			FMath::FloorToInt(LocalCenter.X + LocalRadius), FMath::FloorToInt(LocalCenter.Y + LocalRadius),
+			FMath::FloorToInt(LocalCenter.Z + LocalRadius));
+
+		if (Max.X < 0 || Max.Y < 0 || Max.Z < 0 || Min.X >= GridSize || Min.Y >= GridSize || Min.Z >= GridSize)
+		{
+			return false;
+		}
+
+		Min = FIntVector(FMath::Max(Min.X, 0), FMath::Max(Min.Y, 0), FMath::Max(Min.Z, 0));
+		Max = FIntVector(FMath::Min(Max.X, GridSize - 1), FMath::Min(Max.Y, GridSize - 1), FMath::Min(Max.Z, GridSize - 1));
+
+		return true;
+	};
+
+	// Count the lights within each cluster.
+	ClusterCounts.Reset();
+	ClusterCounts.SetNumZeroed(NumClusters);
+
+	for (const FSphere& Bounds : ProximityLightBounds)
+	{
+		FIntVector Min, Max;
+
+		if (CalculateClusterRange(Bounds, Min, Max))
+		{
+			for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+			{
+				for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+				{
+					for (int32 X = Min.X; X <= Max.X; ++X)
+					{
+						++ClusterCounts[X + ((Y + (Z * GridSize)) * GridSize)];
+					}
+				}
+			}
+		}
+	}
+
+	// Reserve space within the index list for each cluster. Clusters which do not fit are flagged with a negative count so that shaders
+	// fall back to evaluating all lights.
+	ClusterOffsets.SetNumUninitialized(NumClusters);
+	int32 NumIndices = 0;
+
+	for (int32 ClusterIndex = 0; ClusterIndex < NumClusters; ++ClusterIndex)
+	{
+		const int32 Count = ClusterCounts[ClusterIndex];
+
+		if (NumIndices + Count <= MaxIndices)
+		{
+			ClusterOffsets[ClusterIndex] = NumIndices;
+			NumIndices += Count;
+			(*DataTexture)[ClusterTexelIndex + ClusterIndex] = FLinearColor(ClusterOffsets[ClusterIndex], Count, 0, 0);
+		}
+		else
+		{
+			ClusterOffsets[ClusterIndex] = INDEX_NONE;
+			(*DataTexture)[ClusterTexelIndex + ClusterIndex] = FLinearColor(0, -1, 0, 0);
+		}
+	}
+
+	// Write the light indices, four per texel.
+	for (int32 LightIndex = 0; LightIndex < ProximityLightBounds.Num(); ++LightIndex)
+	{
+		FIntVector Min, Max;
+
+		if (CalculateClusterRange(ProximityLightBounds[LightIndex], Min, Max))
+		{
+			for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+			{
+				for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+				{
+					for (int32 X = Min.X; X <= Max.X; ++X)
+					{
+						int32& Offset = ClusterOffsets[X + ((Y + (Z * GridSize)) * GridSize)];
+
+						if (Offset != INDEX_NONE)
+						{
+							(*DataTexture)[IndexTexelIndex + (Offset / 4)].Component(Offset % 4) = LightIndex;
+							++Offset;
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+FVector UGTWorldSubsystem::CalculateClusterOrigin() const
+{
+	const UGTSettings* Settings = GetDefault<UGTSettings>();
+	const float ClusterSize = Settings->ProximityLightClusterSize;
+	const TArray<FVector>& ViewLocations = GetWorld()->ViewLocationsRenderedLastFrame;
+	const FVector Center = ViewLocations.Num() != 0 ? ViewLocations[0] : FVector::ZeroVector;
+
+	// Snap to the cluster size so that the grid only moves (and must be rebuilt) when the view crosses a cell.
+	const FVector Cell = (Center / ClusterSize) - FVector(Settings->ProximityLightClusterGridSize * 0.5f);
+	return FVector(FMath::FloorToDouble(Cell.X), FMath::FloorToDouble(Cell.Y), FMath::FloorToDouble(Cell.Z)) * ClusterSize;
+}
+
+void UGTWorldSubsystem::UpdateStats() const
+{
+	// Counter stats are cleared each frame, so every world adds its own counts.
+	INC_DWORD_STAT_BY(STAT_GTParameterWrites, NumParameterWrites);
+	INC_DWORD_STAT_BY(STAT_GTSkippedParameterWrites, NumSkippedParameterWrites);
+	INC_DWORD_STAT_BY(STAT_GTSkippedTransformUpdates, NumSkippedTransformUpdates);
+
+#if COUNTERSTRACE_ENABLED
+	GTWorldSubsystem::FTraceCounts& TraceCounts = GTWorldSubsystem::TraceCounts;
+
+	if (TraceCounts.Frame != GFrameCounter)
+	{
+		TraceCounts = GTWorldSubsystem::FTraceCounts();
+		TraceCounts.Frame = GFrameCounter;
+	}
+
+	TraceCounts.ParameterWrites += NumParameterWrites;
+	TraceCounts.SkippedParameterWrites += NumSkippedParameterWrites;
+	TraceCounts.SkippedTransformUpdates += NumSkippedTransformUpdates;
+
+	TRACE_COUNTER_SET(GTParameterWrites, TraceCounts.ParameterWrites);
+	TRACE_COUNTER_SET(GTSkippedParameterWrites, TraceCounts.SkippedParameterWrites);
+	TRACE_COUNTER_SET(GTSkippedTransformUpdates, TraceCounts.SkippedTransformUpdates);
+#endif // COUNTERSTRACE_ENABLED
+
+#if STATS
+	const UGTSettings* Settings = GetDefault<UGTSettings>();
+	const int32 MaxDataTextureProximityLights = DataTexture.IsValid() ? Settings->MaxDataTextureProximityLights : 0;
+	const int32 MaxDataTextureClippingPrimitives = DataTexture.IsValid() ? Settings->MaxDataTextureClippingPrimitives : 0;
+	// PackDirectionalLights writes every directional light into the data texture, the lights beyond the first two are collapsed.
+	const int32 MaxDataTextureDirectionalLights = DataTexture.IsValid() ? DirectionalLights.Num() : 0;
+
+	// Components are active when they are written to the WorldParameterCollection or the data texture.
+	auto NumActive = [](const FGTComponentSlots& Components, int32 MaxParameterCollection, int32 MaxDataTexture)
+	{ return FMath::Min(Components.Num(), FMath::Max(MaxParameterCollection, MaxDataTexture)); };
+
+	INC_DWORD_STAT_BY(STAT_GTDirectionalLights, DirectionalLights.Num());
+	INC_DWORD_STAT_BY(STAT_GTActiveDirectionalLights, NumActive(DirectionalLights, 1, MaxDataTextureDirectionalLights));
+	INC_DWORD_STAT_BY(STAT_GTProximityLights, ProximityLights.Num());
+	INC_DWORD_STAT_BY(STAT_GTActiveProximityLights, NumActive(ProximityLights, GT_MAX_PROXIMITY_LIGHTS, MaxDataTextureProximityLights));
+	INC_DWORD_STAT_BY(STAT_GTProximityLightsAwayFromSurfaces, NumProximityLightsAwayFromSurfaces);
+	INC_DWORD_STAT_BY(STAT_GTClippingPlanes, ClippingPlanes.Num());
+	INC_DWORD_STAT_BY(STAT_GTActiveClippingPlanes, NumActive(ClippingPlanes, 1, MaxDataTextureClippingPrimitives));
+	INC_DWORD_STAT_BY(STAT_GTClippingSpheres, ClippingSpheres.Num());
+	INC_DWORD_STAT_BY(STAT_GTActiveClippingSpheres, NumActive(ClippingSpheres, 1, MaxDataTextureClippingPrimitives));
+	INC_DWORD_STAT_BY(STAT_GTClippingBoxes, ClippingBoxes.Num());
+	INC_DWORD_STAT_BY(STAT_GTActiveClippingBoxes, NumActive(ClippingBoxes, 1, MaxDataTextureClippingPrimitives));
+	INC_DWORD_STAT_BY(STAT_GTClippingCones, ClippingCones.Num());
+	INC_DWORD_STAT_BY(STAT_GTActiveClippingCones, NumActive(ClippingCones, 1, MaxDataTextureClippingPrimitives));
+#endif // STATS
+}
+
+#if WITH_EDITOR
+void UGTWorldSubsystem::RebuildStaleParameterCollectionBuffers()
+{
+	bool RebuiltBuffer = false;
+
+	for (auto It = ParameterCollectionBuffers.CreateIterator(); It; ++It)
+	{
+		if (It.Value()->GetCollection() == nullptr)
+		{
+			// The collection has been deleted or unloaded.
+			It.RemoveCurrent();
+		}
+		else if (It.Value()->IsStale())
+		{
+			It.Value()->Rebuild();
+			RebuiltBuffer = true;
+		}
+	}
+
+	if (RebuiltBuffer)
+	{
+		// Parameters may have been added or removed, so re-send the state of all world components.
+		for (const FGTComponentSlots* Components :
+			 {&DirectionalLights, &ProximityLights, &ClippingPlanes, &ClippingSpheres, &ClippingBoxes, &ClippingCones})
+		{
+			for (UGTSceneComponent* Component : Components->GetSlots())
+			{
+				if (Component != nullptr)
+				{
+					DirtyComponents.Add(Component);
+				}
+			}
+		}
+	}
+}
+#endif // WITH_EDITOR
+
+TStatId UGTWorldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGTWorldSubsystem, STATGROUP_Tickables);
+}
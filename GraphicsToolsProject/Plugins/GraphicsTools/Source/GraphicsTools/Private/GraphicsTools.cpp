@@ -3,6 +3,8 @@
 
 #include "GraphicsTools.h"
 
+#include "GTFakeHandTracker.h"
+
 #include "ShaderCore.h"
 
 #include "Features/IModularFeatures.h"
@@ -10,6 +12,39 @@
 
 DEFINE_LOG_CATEGORY(GraphicsTools)
 
+UE_TRACE_CHANNEL_DEFINE(GraphicsToolsChannel)
+
+DEFINE_STAT(STAT_GTFlushDirtyComponents);
+DEFINE_STAT(STAT_GTSelectProximityLights);
+DEFINE_STAT(STAT_GTUpdateDataTexture);
+DEFINE_STAT(STAT_GTFlushParameterCollections);
+DEFINE_STAT(STAT_GTUpdateDirectionalLight);
+DEFINE_STAT(STAT_GTUpdateProximityLight);
+DEFINE_STAT(STAT_GTUpdateProximityLightPulses);
+DEFINE_STAT(STAT_GTUpdateHandJointLights);
+DEFINE_STAT(STAT_GTUpdateProximityLightSurfaces);
+DEFINE_STAT(STAT_GTUpdateClippingPrimitive);
+DEFINE_STAT(STAT_GTUpdateClippingCulling);
+DEFINE_STAT(STAT_GTUpdateMeshOutlineMaterial);
+DEFINE_STAT(STAT_GTVisualProfilerTick);
+
+DEFINE_STAT(STAT_GTParameterWrites);
+DEFINE_STAT(STAT_GTSkippedParameterWrites);
+DEFINE_STAT(STAT_GTSkippedTransformUpdates);
+DEFINE_STAT(STAT_GTDirectionalLights);
+DEFINE_STAT(STAT_GTActiveDirectionalLights);
+DEFINE_STAT(STAT_GTProximityLights);
+DEFINE_STAT(STAT_GTActiveProximityLights);
+DEFINE_STAT(STAT_GTProximityLightsAwayFromSurfaces);
+DEFINE_STAT(STAT_GTClippingPlanes);
+DEFINE_STAT(STAT_GTActiveClippingPlanes);
+DEFINE_STAT(STAT_GTClippingSpheres);
+DEFINE_STAT(STAT_GTActiveClippingSpheres);
+DEFINE_STAT(STAT_GTClippingBoxes);
+DEFINE_STAT(STAT_GTActiveClippingBoxes);
+DEFINE_STAT(STAT_GTClippingCones);
+DEFINE_STAT(STAT_GTActiveClippingCones);
+
 #define LOCTEXT_NAMESPACE "FGraphicsToolsModule"
 
 void FGraphicsToolsModule::StartupModule()
@@ -21,6 +56,7 @@ void FGraphicsToolsModule::StartupModule()
 
 void FGraphicsToolsModule::ShutdownModule()
 {
+	FGTFakeHandTracker::Unregister();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -26,5 +26,18 @@ protected:
 	// UGTSceneComponent interface
 
 	/** Accessor to all UGTClippingBoxComponent components within a world writing to the WorldParameterCollection. */
-	virtual TArray<UGTSceneComponent*>& GetWorldComponents() override;
+	virtual FGTComponentSlots& GetWorldComponents() override;
+
+	//
+	// UGTClippingPrimitiveComponent interface
+
+	/** Calculates the signed distance from a point to the box. */
+	virtual float CalculateSignedDistance(const FVector& Point) const override;
+
+	/** Calculates the signed distance from each point to the box, four points at a time. */
+	virtual void CalculateSignedDistances(
+		TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, TArrayView<float> OutDistances) const override;
+
+	/** The box's distance is calculated in local space, so scales with the inverse of the smallest axis scale. */
+	virtual float GetDistanceScale() const override { return CalculateInverseTransformDistanceScale(); }
 };
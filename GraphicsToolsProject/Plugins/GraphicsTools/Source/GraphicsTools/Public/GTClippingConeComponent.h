@@ -14,7 +14,9 @@
  * represent the radius of those two faces. The orientation and height of the cone is described by the vector between the top and bottom
  * points direction and magnitude respectively. To change the height, top radius, or bottom radius of the cone adjust the scale of the
  * component. The scale along the x-axis is the height, and scale along y-axis is the bottom radius, and the scale along the z-axis is the
- * top radius. If the y and z axis scales are the same the cone becomes a capped cylinder.
+ * top radius. If the y and z axis scales are the same the cone becomes a capped cylinder. The third and fourth transform columns hold
+ * values which only depend on the cone's transform, materials which use GTPointVsConePrecomputed read these rather than recalculating
+ * them per pixel.
  */
 UCLASS(ClassGroup = (GraphicsTools), meta = (BlueprintSpawnableComponent))
 class GRAPHICSTOOLS_API UGTClippingConeComponent : public UGTClippingPrimitiveComponent
@@ -28,14 +30,25 @@ protected:
 	// UGTSceneComponent interface
 
 	/** Accessor to all UGTClippingConeComponent components within a world writing to the WorldParameterCollection. */
-	virtual TArray<UGTSceneComponent*>& GetWorldComponents() override;
+	virtual FGTComponentSlots& GetWorldComponents() override;
 
 	//
 	// UGTClippingPrimitiveComponent interface
 
-	/** Sends the cone's end points and radii into the current parameter collection. */
-	virtual void UpdateParameterCollectionTransform() override;
+	/** Calculates the cone's end points and radii, followed by the invariants materials would otherwise calculate per pixel. */
+	virtual void CalculateTransformColumns(FLinearColor* Columns) const override;
 
-	/** Cone's only need two FVectors (two points and two radii) to specify their transform. */
-	virtual int32 GetTransformColumnCount() const override { return 2; }
+	/** Cone's need two FVectors (two points and two radii) to specify their transform, plus two FVectors of invariants. */
+	virtual int32 GetTransformColumnCount() const override { return 4; }
+
+	/** Only the points and radii are required. The invariants are written when their parameter names are set, since MPC_GTSettings does
+	 * not contain them. */
+	virtual int32 GetRequiredTransformColumnCount() const override { return 2; }
+
+	/** Calculates the signed distance from a point to the cone. */
+	virtual float CalculateSignedDistance(const FVector& Point) const override;
+
+	/** Calculates the signed distance from each point to the cone, four points at a time. */
+	virtual void CalculateSignedDistances(
+		TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, TArrayView<float> OutDistances) const override;
 };
@@ -0,0 +1,134 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Components/ActorComponent.h"
+
+#include "GTClippingCullingComponent.generated.h"
+
+class UMaterialInterface;
+class UPrimitiveComponent;
+
+/** Culling state of a single primitive component managed by a UGTClippingCullingComponent. */
+USTRUCT()
+struct FGTClippingCullingState
+{
+	GENERATED_BODY()
+
+	/** The primitive being culled. */
+	UPROPERTY()
+	TWeakObjectPtr<UPrimitiveComponent> Primitive;
+
+	/** The primitive's materials before they were replaced with unclipped materials, empty when the materials are not replaced. */
+	UPROPERTY()
+	TArray<UMaterialInterface*> ClippedMaterials;
+
+	/** True when the primitive has been hidden because it is entirely clipped. */
+	bool bHidden = false;
+};
+
+/**
+ * Opt-in component which tests the bounds of its owner's primitive components against the clipping primitives registered with the world.
+ * Primitives which are entirely clipped are hidden so they no longer cost a draw. Primitives which are entirely unclipped can swap to a
+ * material variant without clipping, so their pixels no longer evaluate clipping primitive distances. The world subsystem spreads the tests
+ * of every culling component across frames, see ClippingCullingComponentsPerFrame within the Graphics Tools project settings. Culling only
+ * occurs within game worlds.
+ */
+UCLASS(ClassGroup = (GraphicsTools), meta = (BlueprintSpawnableComponent))
+class GRAPHICSTOOLS_API UGTClippingCullingComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	/** Gets if entirely clipped primitives are hidden. */
+	UFUNCTION(BlueprintGetter, Category = "Clipping Culling")
+	bool GetHideClippedPrimitives() const { return bHideClippedPrimitives; }
+
+	/** Sets if entirely clipped primitives are hidden. */
+	UFUNCTION(BlueprintSetter, Category = "Clipping Culling")
+	void SetHideClippedPrimitives(bool Hide);
+
+	/** Gets the map of clipping materials to material variants without clipping. */
+	UFUNCTION(BlueprintGetter, Category = "Clipping Culling")
+	const TMap<UMaterialInterface*, UMaterialInterface*>& GetUnclippedMaterials() const { return UnclippedMaterials; }
+
+	/** Sets the map of clipping materials to material variants without clipping. */
+	UFUNCTION(BlueprintSetter, Category = "Clipping Culling")
+	void SetUnclippedMaterials(const TMap<UMaterialInterface*, UMaterialInterface*>& Materials);
+
+	/** Gets the clipping groups the owner's primitives are tested against. */
+	UFUNCTION(BlueprintGetter, Category = "Clipping Culling")
+	int32 GetClippingGroupMask() const { return ClippingGroupMask; }
+
+	/** Sets the clipping groups the owner's primitives are tested against. */
+	UFUNCTION(BlueprintSetter, Category = "Clipping Culling")
+	void SetClippingGroupMask(int32 Mask) { ClippingGroupMask = Mask; }
+
+	/** Gets the EGTClippingPrimitiveType types the owner's primitives are tested against. */
+	UFUNCTION(BlueprintGetter, Category = "Clipping Culling")
+	int32 GetClippingPrimitiveTypes() const { return ClippingPrimitiveTypes; }
+
+	/** Sets the EGTClippingPrimitiveType types the owner's primitives are tested against. */
+	UFUNCTION(BlueprintSetter, Category = "Clipping Culling")
+	void SetClippingPrimitiveTypes(int32 Types) { ClippingPrimitiveTypes = Types; }
+
+	/** Re-gathers the owner's primitive components, call after adding or removing primitive components from the owner. */
+	UFUNCTION(BlueprintCallable, Category = "Clipping Culling")
+	void RefreshPrimitives();
+
+	/** Tests each primitive against the world's clipping primitives and hides or swaps materials as needed. Called by the world
+	 * subsystem. */
+	void UpdateCulling();
+
+protected:
+	//
+	// UActorComponent interface
+
+	/** Gathers the owner's primitives and registers with the world subsystem. */
+	virtual void OnRegister() override;
+
+	/** Restores all primitives and unregisters from the world subsystem. */
+	virtual void OnUnregister() override;
+
+private:
+	/** Returns all primitives to their original visibility and materials. */
+	void RestorePrimitives();
+
+	/** Shows or hides a primitive. */
+	void SetPrimitiveHidden(FGTClippingCullingState& State, bool Hidden);
+
+	/** Swaps a primitive's materials to their unclipped variant, or back to the original materials. */
+	void SetPrimitiveUnclipped(FGTClippingCullingState& State, bool Unclipped);
+
+	/** When true primitives which are entirely clipped are hidden. */
+	UPROPERTY(
+		EditAnywhere, Category = "Clipping Culling", BlueprintGetter = "GetHideClippedPrimitives",
+		BlueprintSetter = "SetHideClippedPrimitives")
+	bool bHideClippedPrimitives = true;
+
+	/** Maps each material which evaluates clipping primitives to a variant which does not. Primitives which are entirely unclipped use
+	 * the variant, materials not in the map are left unchanged. */
+	UPROPERTY(
+		EditAnywhere, Category = "Clipping Culling", BlueprintGetter = "GetUnclippedMaterials", BlueprintSetter = "SetUnclippedMaterials")
+	TMap<UMaterialInterface*, UMaterialInterface*> UnclippedMaterials;
+
+	/** The clipping groups the owner's primitives are tested against, this should match the mask the owner's materials use. */
+	UPROPERTY(
+		EditAnywhere, Category = "Clipping Culling", BlueprintGetter = "GetClippingGroupMask", BlueprintSetter = "SetClippingGroupMask",
+		meta = (Bitmask))
+	int32 ClippingGroupMask = -1;
+
+	/** The clipping primitive types the owner's primitives are tested against, this should match the MF_GTClipping* functions the owner's
+	 * materials evaluate. A primitive is never hidden by a clipping primitive type its materials ignore. */
+	UPROPERTY(
+		EditAnywhere, Category = "Clipping Culling", BlueprintGetter = "GetClippingPrimitiveTypes",
+		BlueprintSetter = "SetClippingPrimitiveTypes", meta = (Bitmask, BitmaskEnum = "EGTClippingPrimitiveType"))
+	int32 ClippingPrimitiveTypes = -1;
+
+	/** Culling state of each of the owner's primitive components. */
+	UPROPERTY(Transient)
+	TArray<FGTClippingCullingState> Primitives;
+};
@@ -0,0 +1,144 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "GTClippingFunctionLibrary.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UPrimitiveComponent;
+
+/** The number of per instance custom data floats used by instanced clipping, a clipping group mask followed by a plane. */
+#define GT_CLIPPING_INSTANCE_DATA_FLOATS 5
+
+/** Clipping primitive types, combined into a mask to select which types a world query considers. */
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EGTClippingPrimitiveType : uint8
+{
+	None = 0 UMETA(Hidden),
+	Plane = 1 << 0,
+	Sphere = 1 << 1,
+	Box = 1 << 2,
+	Cone = 1 << 3
+};
+ENUM_CLASS_FLAGS(EGTClippingPrimitiveType);
+
+/**
+ * CPU versions of the clipping primitive signed distance functions within GTClipping.ush, plus queries against every clipping primitive
+ * registered with a world. Distances are positive when a point is kept and negative when a point is clipped, a clipping side of 1 clips the
+ * inside of a primitive and -1 clips the outside.
+ */
+UCLASS(ClassGroup = GraphicsTools)
+class GRAPHICSTOOLS_API UGTClippingFunctionLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/** Signed distance from a point to a plane described by a normal (xyz) and distance from the origin along the normal (w). */
+	UFUNCTION(BlueprintPure, Category = "Graphics Tools|Clipping")
+	static float PointVsPlane(const FVector& Point, const FVector4& Plane, float ClippingSide);
+
+	/** Signed distance from a point to a unit diameter sphere transformed by the inverse of SphereInverseTransform. */
+	UFUNCTION(BlueprintPure, Category = "Graphics Tools|Clipping")
+	static float PointVsSphere(const FVector& Point, const FMatrix& SphereInverseTransform, float ClippingSide);
+
+	/** Signed distance from a point to a unit box transformed by the inverse of BoxInverseTransform. */
+	UFUNCTION(BlueprintPure, Category = "Graphics Tools|Clipping")
+	static float PointVsBox(const FVector& Point, const FMatrix& BoxInverseTransform, float ClippingSide);
+
+	/** Signed distance from a point to a capped cone described by a start point and radius (xyz, w) and an end point and radius. */
+	UFUNCTION(BlueprintPure, Category = "Graphics Tools|Clipping")
+	static float PointVsCone(const FVector& Point, const FVector4& ConeStart, const FVector4& ConeEnd, float ClippingSide);
+
+	/** Returns the combined signed distance from a point to every clipping primitive registered with a world, the same distance materials
+	 * calculate when the minimum of each primitive type is taken. Returns FLT_MAX when no clipping primitives are registered. When the data
+	 * texture is enabled only primitives within a clipping group selected by ClippingGroupMask are considered, -1 selects every group. Only
+	 * the EGTClippingPrimitiveType types within PrimitiveTypeMask are considered, which should match the types a material evaluates. */
+	UFUNCTION(BlueprintPure, Category = "Graphics Tools|Clipping", meta = (WorldContext = "WorldContextObject"))
+	static float GetClippingDistance(
+		const UObject* WorldContextObject, const FVector& Point, int32 ClippingGroupMask = -1,
+		UPARAM(meta = (Bitmask, BitmaskEnum = "EGTClippingPrimitiveType")) int32 PrimitiveTypeMask = -1);
+
+	/** Returns true if a point is clipped by the clipping primitives registered with a world. */
+	UFUNCTION(BlueprintPure, Category = "Graphics Tools|Clipping", meta = (WorldContext = "WorldContextObject"))
+	static bool IsPointClipped(
+		const UObject* WorldContextObject, const FVector& Point, int32 ClippingGroupMask = -1,
+		UPARAM(meta = (Bitmask, BitmaskEnum = "EGTClippingPrimitiveType")) int32 PrimitiveTypeMask = -1);
+
+	/** Returns true if every point within the bounds is clipped by the clipping primitives registered with a world. The test is
+	 * conservative, bounds which are only just clipped may be reported as not clipped but visible bounds are never reported as clipped. */
+	UFUNCTION(BlueprintPure, Category = "Graphics Tools|Clipping", meta = (WorldContext = "WorldContextObject"))
+	static bool IsBoundsClipped(
+		const UObject* WorldContextObject, const FBoxSphereBounds& Bounds, int32 ClippingGroupMask = -1,
+		UPARAM(meta = (Bitmask, BitmaskEnum = "EGTClippingPrimitiveType")) int32 PrimitiveTypeMask = -1);
+
+	/** Returns true if no point within the bounds is clipped by the clipping primitives registered with a world. Like IsBoundsClipped the
+	 * test is conservative, partially clipped bounds are never reported as unclipped. */
+	UFUNCTION(BlueprintPure, Category = "Graphics Tools|Clipping", meta = (WorldContext = "WorldContextObject"))
+	static bool IsBoundsUnclipped(
+		const UObject* WorldContextObject, const FBoxSphereBounds& Bounds, int32 ClippingGroupMask = -1,
+		UPARAM(meta = (Bitmask, BitmaskEnum = "EGTClippingPrimitiveType")) int32 PrimitiveTypeMask = -1);
+
+	/** Stores a clipping group mask into a primitive's custom primitive data, so that materials which pass that custom primitive data to
+	 * the Masked data texture clipping functions are only clipped by primitives within the selected groups. */
+	UFUNCTION(BlueprintCallable, Category = "Graphics Tools|Clipping")
+	static void SetClippingGroupMask(UPrimitiveComponent* Primitive, int32 DataIndex, int32 ClippingGroupMask);
+
+	/** Stores a clipping group mask into an instance's per instance custom data at DataIndex, the instanced equivalent of
+	 * SetClippingGroupMask for materials which use GTClippingInstanceData. Returns false if the instance or custom data index is invalid,
+	 * the component needs at least DataIndex + GT_CLIPPING_INSTANCE_DATA_FLOATS custom data floats. */
+	UFUNCTION(BlueprintCallable, Category = "Graphics Tools|Clipping")
+	static bool SetInstanceClippingGroupMask(
+		UInstancedStaticMeshComponent* Instances, int32 InstanceIndex, int32 DataIndex, int32 ClippingGroupMask,
+		bool MarkRenderStateDirty = true);
+
+	/** Stores a world space clipping plane, described by a normal (xyz) and distance from the origin along the normal (w), into an
+	 * instance's per instance custom data after the clipping group mask at DataIndex. Points behind the plane are clipped, like a clipping
+	 * plane component which clips its inside, and a zero plane disables the instance's plane. Returns false if the instance or custom data
+	 * index is invalid. */
+	UFUNCTION(BlueprintCallable, Category = "Graphics Tools|Clipping")
+	static bool SetInstanceClippingPlane(
+		UInstancedStaticMeshComponent* Instances, int32 InstanceIndex, int32 DataIndex, const FVector4& Plane,
+		bool MarkRenderStateDirty = true);
+
+	/** Returns the combined signed distance from a point to the clipping primitives selected by an instance's clipping group mask and the
+	 * instance's own plane, the same distance GTClippingInstanceData calculates. The clipping group mask is ignored when the data texture
+	 * is disabled, since materials then have no clipping primitives to read. Returns FLT_MAX when nothing clips the instance. */
+	UFUNCTION(BlueprintPure, Category = "Graphics Tools|Clipping")
+	static float GetInstanceClippingDistance(
+		const UInstancedStaticMeshComponent* Instances, int32 InstanceIndex, int32 DataIndex, const FVector& Point);
+
+	//
+	// Batch versions of the above for large point sets, such as particles or point clouds. Points are passed as structure of arrays, each
+	// function evaluates four points per SIMD instruction and splits large batches across worker threads. X, Y, Z and OutDistances must
+	// all have the same number of elements.
+
+	/** Batch version of PointVsPlane. */
+	static void PointsVsPlane(
+		TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, const FVector4& Plane, float ClippingSide,
+		TArrayView<float> OutDistances);
+
+	/** Batch version of PointVsSphere. */
+	static void PointsVsSphere(
+		TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, const FMatrix& SphereInverseTransform,
+		float ClippingSide, TArrayView<float> OutDistances);
+
+	/** Batch version of PointVsBox. */
+	static void PointsVsBox(
+		TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, const FMatrix& BoxInverseTransform,
+		float ClippingSide, TArrayView<float> OutDistances);
+
+	/** Batch version of PointVsCone. */
+	static void PointsVsCone(
+		TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, const FVector4& ConeStart, const FVector4& ConeEnd,
+		float ClippingSide, TArrayView<float> OutDistances);
+
+	/** Batch version of GetClippingDistance. */
+	static void GetClippingDistances(
+		const UObject* WorldContextObject, TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z,
+		TArrayView<float> OutDistances, int32 ClippingGroupMask = -1, int32 PrimitiveTypeMask = -1);
+};
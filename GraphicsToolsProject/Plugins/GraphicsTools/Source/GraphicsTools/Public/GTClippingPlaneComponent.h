@@ -25,14 +25,27 @@ protected:
 	// UGTSceneComponent interface
 
 	/** Accessor to all UGTClippingPlaneComponent components within a world writing to the WorldParameterCollection. */
-	virtual TArray<UGTSceneComponent*>& GetWorldComponents() override;
+	virtual FGTComponentSlots& GetWorldComponents() override;
 
 	//
 	// UGTClippingPrimitiveComponent interface
 
-	/** Sends the plane's normal and distance from the origin into the current parameter collection. */
-	virtual void UpdateParameterCollectionTransform() override;
+	/** Calculates the plane's normal and distance from the origin. */
+	virtual void CalculateTransformColumns(FLinearColor* Columns) const override;
 
 	/** Plane's only need single FVector to specify their transform. */
 	virtual int32 GetTransformColumnCount() const override { return 1; }
+
+	/** Calculates the signed distance from a point to the plane. */
+	virtual float CalculateSignedDistance(const FVector& Point) const override;
+
+	/** Calculates the signed distance from each point to the plane, four points at a time. */
+	virtual void CalculateSignedDistances(
+		TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, TArrayView<float> OutDistances) const override;
+
+	/** Calculates the exact maximum signed distance of the bounding box, the furthest corner along the plane's normal. */
+	virtual float CalculateMaxSignedDistance(const FBoxSphereBounds& Bounds) const override;
+
+	/** Calculates the exact minimum signed distance of the bounding box, the nearest corner along the plane's normal. */
+	virtual float CalculateMinSignedDistance(const FBoxSphereBounds& Bounds) const override;
 };
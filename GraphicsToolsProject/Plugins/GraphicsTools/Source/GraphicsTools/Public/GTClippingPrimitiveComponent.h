@@ -10,6 +10,10 @@
 
 class UMaterialParameterCollection;
 
+/** The number of clipping groups, masks are stored in floats so they are limited to the bits a float represents exactly. */
+#define GT_CLIPPING_GROUP_BITS 24
+#define GT_CLIPPING_GROUPS_ALL ((1 << GT_CLIPPING_GROUP_BITS) - 1)
+
 UENUM(BlueprintType)
 enum class EGTClippingSide : uint8
 {
@@ -41,6 +45,14 @@ public:
 	UFUNCTION(BlueprintSetter, Category = "Clipping Primitive")
 	void SetClippingSide(EGTClippingSide Side);
 
+	/** Gets the bitmask of clipping groups this primitive belongs to. */
+	UFUNCTION(BlueprintGetter, Category = "Clipping Primitive")
+	int32 GetClippingGroups() const { return ClippingGroups; }
+
+	/** Sets the bitmask of clipping groups this primitive belongs to, only the lower GT_CLIPPING_GROUP_BITS bits are used. */
+	UFUNCTION(BlueprintSetter, Category = "Clipping Primitive")
+	void SetClippingGroups(int32 Groups);
+
 	/** Gets the material parameter name used for general settings. */
 	UFUNCTION(BlueprintPure, Category = "Clipping Primitive")
 	const FName& GetSettingsParameterName() const { return SettingsParameterName; }
@@ -57,6 +69,32 @@ public:
 	UFUNCTION(BlueprintSetter, Category = "Clipping Primitive")
 	void SetTransformColumnParameterNames(const TArray<FName>& Names);
 
+	/** Writes the primitive's settings followed by each transform column to consecutive values. This is the layout used by both the
+	 * WorldParameterCollection and the data texture. */
+	void PackPrimitiveData(FLinearColor* Data, bool IsDisabled = false) const;
+
+	/** Returns the signed distance from a world space point to the primitive, matching the distance materials calculate. Negative distances
+	 * are clipped. */
+	UFUNCTION(BlueprintPure, Category = "Clipping Primitive")
+	float GetSignedDistance(const FVector& Point) const { return CalculateSignedDistance(Point); }
+
+	/** Batch version of GetSignedDistance for a structure of arrays of points, see UGTClippingFunctionLibrary::PointsVsPlane. */
+	void GetSignedDistances(
+		TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, TArrayView<float> OutDistances) const
+	{
+		CalculateSignedDistances(X, Y, Z, OutDistances);
+	}
+
+	/** Returns an upper bound of the signed distance of every point within the world space bounds. A negative result means the bounds
+	 * are entirely clipped by this primitive. */
+	UFUNCTION(BlueprintPure, Category = "Clipping Primitive")
+	float GetMaxSignedDistance(const FBoxSphereBounds& Bounds) const { return CalculateMaxSignedDistance(Bounds); }
+
+	/** Returns a lower bound of the signed distance of every point within the world space bounds. A positive result means no point within
+	 * the bounds is clipped by this primitive. */
+	UFUNCTION(BlueprintPure, Category = "Clipping Primitive")
+	float GetMinSignedDistance(const FBoxSphereBounds& Bounds) const { return CalculateMinSignedDistance(Bounds); }
+
 protected:
 	//
 	// UObject interface
@@ -75,20 +113,87 @@ protected:
 	//
 	// UGTSceneComponent interface
 
+	/** Resolves the settings and transform column parameter indices. */
+	virtual void CacheParameterIndices() override;
+
 	/** Updates the current parameter collection based on the current primitive. */
 	virtual void UpdateParameterCollection(bool IsDisabled = false) override;
 
-	/** Sends the primitive's transform into the current parameter collection. */
-	virtual void UpdateParameterCollectionTransform();
+	/** Sends only the primitive's transform into the current parameter collection. */
+	virtual void UpdateParameterCollectionTransform() override;
+
+	/** Calculates each of the GetTransformColumnCount columns which describe the primitive's transform. By default the columns of the
+	 * inverse transformation matrix. */
+	virtual void CalculateTransformColumns(FLinearColor* Columns) const;
 
 	/** The number of column's this primitives transform expects. */
 	virtual int32 GetTransformColumnCount() const { return 4; }
 
+	/** The number of columns which must be named, any further columns are optional and only written when named. */
+	virtual int32 GetRequiredTransformColumnCount() const { return GetTransformColumnCount(); }
+
+	/** Calculates the signed distance from a world space point to the primitive. */
+	virtual float CalculateSignedDistance(const FVector& Point) const
+		PURE_VIRTUAL(UGTClippingPrimitiveComponent::CalculateSignedDistance, return FLT_MAX;);
+
+	/** Calculates the signed distance from each point to the primitive. By default calls CalculateSignedDistance for each point. */
+	virtual void CalculateSignedDistances(
+		TArrayView<const float> X, TArrayView<const float> Y, TArrayView<const float> Z, TArrayView<float> OutDistances) const;
+
+	/** Calculates an upper bound of the signed distance of every point within the bounds. By default the distance at the center of the
+	 * bounds grown by the bounding sphere radius scaled by GetDistanceScale. */
+	virtual float CalculateMaxSignedDistance(const FBoxSphereBounds& Bounds) const;
+
+	/** Calculates a lower bound of the signed distance of every point within the bounds. By default the distance at the center of the
+	 * bounds shrunk by the bounding sphere radius scaled by GetDistanceScale. */
+	virtual float CalculateMinSignedDistance(const FBoxSphereBounds& Bounds) const;
+
+	/** The largest change in signed distance per unit change in world location. Distances calculated in world space change at most one
+	 * unit per unit, distances calculated in a scaled local space can change faster. */
+	virtual float GetDistanceScale() const { return 1; }
+
+	/** Returns the primitive's world to local matrix, which materials use to transform pixels into a unit primitive. */
+	FMatrix CalculateInverseTransform() const;
+
+	/** Returns CalculateInverseTransform rebuilt from the cached GetTransformColumns, so repeated distance queries do not invert the
+	 * component transform each call. Only valid for primitives which use the default CalculateTransformColumns. */
+	FMatrix GetCachedInverseTransform() const;
+
+	/** Returns the distance scale of a primitive whose distance is calculated within the space of CalculateInverseTransform. */
+	float CalculateInverseTransformDistanceScale() const;
+
+	/** Returns 1 when the inside of the primitive is clipped, else -1. */
+	float GetClippingSideSign() const { return GetClippingSide() == EGTClippingSide::Inside ? 1 : -1; }
+
+	/** Accessor to the parameter indices resolved from the transform column parameter names. */
+	const TArray<int32>& GetTransformColumnParameterIndices() const { return TransformColumnParameterIndices; }
+
+	/** Returns the GetTransformColumnCount transform columns. The columns are cached and only recalculated when the component transform
+	 * has changed since they were last calculated. */
+	const FLinearColor* GetTransformColumns() const;
+
 private:
+	/** Returns true if this primitive writes to its parameter collection. */
+	bool IsWritingParameterCollection() const;
+
+	/** Writes each transform column into the current parameter collection. */
+	void SetTransformColumnParameterValues();
+
+	/** Packs if the primitive is enabled (x), the clipping side (y), and the clipping groups (z). */
+	FLinearColor CalculateSettings(bool IsDisabled) const;
+
 	/** Specifies if the primitive discards pixels on the inside or outside of the primitive shape. */
 	UPROPERTY(EditAnywhere, Category = "Clipping Primitive", BlueprintGetter = "GetClippingside", BlueprintSetter = "SetClippingside")
 	EGTClippingSide ClippingSide = EGTClippingSide::Inside;
 
+	/** The clipping groups this primitive belongs to. Materials which use the Masked data texture clipping functions are only clipped by
+	 * primitives in a group selected by the mesh's mask, see UGTClippingFunctionLibrary::SetClippingGroupMask. A primitive in no groups
+	 * does not clip data texture materials. */
+	UPROPERTY(
+		EditAnywhere, Category = "Clipping Primitive", BlueprintGetter = "GetClippingGroups", BlueprintSetter = "SetClippingGroups",
+		meta = (Bitmask))
+	int32 ClippingGroups = 1;
+
 	/** Material parameter name used for general primitive settings to pass to a material. */
 	UPROPERTY(
 		EditAnywhere, Category = "Clipping Primitive", BlueprintGetter = "GetSettingsParameterName",
@@ -100,4 +205,17 @@ private:
 		EditAnywhere, Category = "Clipping Primitive", BlueprintGetter = "GetTransformColumnParameterNames",
 		BlueprintSetter = "SetTransformColumnParameterNames", AdvancedDisplay)
 	TArray<FName> TransformColumnParameterNames;
+
+	/** Parameter indices resolved from the above parameter names. */
+	int32 SettingsParameterIndex = INDEX_NONE;
+	TArray<int32> TransformColumnParameterIndices;
+
+	/** Transform columns cached by GetTransformColumns and the transform they were calculated from. */
+	mutable FLinearColor CachedTransformColumns[4];
+	mutable FTransform CachedColumnsTransform;
+	mutable bool bTransformColumnsCached = false;
+
+	/** The transform last sent to the parameter collection and data texture, transform updates which match it are skipped. */
+	FTransform UploadedTransform;
+	bool bTransformUploaded = false;
 };
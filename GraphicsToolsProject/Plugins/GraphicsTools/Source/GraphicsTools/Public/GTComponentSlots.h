@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UGTSceneComponent;
+
+/**
+ * Stable slot allocator for all components of a single type within a world. Freed slots are recycled most recently freed first through a
+ * doubly linked free list, so adding or removing a component is constant time (amortized over the trimming of trailing free slots) and
+ * never shifts the slot of any other component. The exception is when a component is removed from one of the active slots (the slots which
+ * are written to a material parameter collection); the component in the highest slot is then moved into the freed slot so that the active
+ * slots remain filled. Because of that move the order free slots are reused in does not matter.
+ */
+class GRAPHICSTOOLS_API FGTComponentSlots
+{
+public:
+	/** Assigns the component to the most recently freed slot, or a new slot, and returns the slot index. */
+	int32 Add(UGTSceneComponent* Component);
+
+	/** Frees a slot. If a component was moved into the freed slot to keep the active slots filled it is returned, else null is returned. */
+	UGTSceneComponent* Remove(int32 SlotIndex, int32 NumActiveSlots);
+
+	/** Returns the component within a slot, or null if the slot is free. */
+	UGTSceneComponent* operator[](int32 SlotIndex) const { return Slots.IsValidIndex(SlotIndex) ? Slots[SlotIndex] : nullptr; }
+
+	/** The number of components which currently occupy a slot. */
+	int32 Num() const { return Count; }
+
+	/** All slots, free slots contain null. */
+	const TArray<UGTSceneComponent*>& GetSlots() const { return Slots; }
+
+private:
+	/** Links a free slot at the head of the free list. */
+	void PushFreeSlot(int32 SlotIndex);
+
+	/** Removes a free slot from anywhere within the free list. */
+	void UnlinkFreeSlot(int32 SlotIndex);
+
+	/** Removes free slots from the end of the slot array. */
+	void TrimFreeSlots();
+
+	TArray<UGTSceneComponent*> Slots;
+
+	/** The next and previous free slot of each free slot, only meaningful for slots which are free. Linked in both directions so that
+	 * trimmed slots can be unlinked without searching the list. */
+	TArray<int32> FreeNext;
+	TArray<int32> FreePrev;
+
+	/** The most recently freed slot, or INDEX_NONE. */
+	int32 FreeHead = INDEX_NONE;
+
+	int32 Count = 0;
+};
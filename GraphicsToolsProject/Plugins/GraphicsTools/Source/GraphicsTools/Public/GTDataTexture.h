@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "UObject/GCObject.h"
+
+class UTexture2D;
+
+/** Width of the data texture in texels, must match GT_DATA_TEXTURE_WIDTH within GTData.ush. */
+#define GT_DATA_TEXTURE_WIDTH 64
+
+/** Number of texels reserved at the start of the data texture for section counts and offsets. */
+#define GT_DATA_TEXTURE_HEADER_TEXELS 9
+
+/** Header texel which stores the proximity light count (x) and the texel offset of the first proximity light (y). */
+#define GT_DATA_TEXTURE_PROXIMITY_LIGHT_HEADER 0
+
+/** Header texels which store the cluster grid origin and cell size (x, y, z, w), then the grid size (x), texel offset of the cells (y), and
+ * texel offset of the light index list (z). */
+#define GT_DATA_TEXTURE_PROXIMITY_LIGHT_CLUSTER_HEADER 1
+
+/** Number of texels used to represent a single proximity light. */
+#define GT_DATA_TEXTURE_PROXIMITY_LIGHT_TEXELS 6
+
+/** Header texels which store the count (x), texel offset of the first primitive (y), and combine mode (z) of each clipping primitive type. */
+#define GT_DATA_TEXTURE_CLIPPING_PLANE_HEADER 3
+#define GT_DATA_TEXTURE_CLIPPING_SPHERE_HEADER 4
+#define GT_DATA_TEXTURE_CLIPPING_BOX_HEADER 5
+#define GT_DATA_TEXTURE_CLIPPING_CONE_HEADER 6
+
+/** Header texel which stores a world space sphere (x, y, z, w) bounding the influence of every proximity light, so that shaders can skip
+ * all proximity lights with a single test. */
+#define GT_DATA_TEXTURE_PROXIMITY_LIGHT_BOUNDS_HEADER 7
+
+/** Header texel which stores the directional light count (x) and the texel offset of the directional light section (y). */
+#define GT_DATA_TEXTURE_DIRECTIONAL_LIGHT_HEADER 8
+
+/** Number of texels in the directional light section. The two strongest lights are stored as a direction and enabled state texel and a
+ * color and intensity texel each. Then the remaining lights, followed by every light, are each collapsed into a dominant direction, color,
+ * and ambient color texel. */
+#define GT_DATA_TEXTURE_DIRECTIONAL_LIGHT_TEXELS 10
+
+/** Number of texels used to represent a single clipping primitive of each type, the settings followed by each transform column. */
+#define GT_DATA_TEXTURE_CLIPPING_PLANE_TEXELS 2
+#define GT_DATA_TEXTURE_CLIPPING_SPHERE_TEXELS 5
+#define GT_DATA_TEXTURE_CLIPPING_BOX_TEXELS 5
+#define GT_DATA_TEXTURE_CLIPPING_CONE_TEXELS 5
+
+/**
+ * A float4 texture which holds the packed state of any number of Graphics Tools components. Texels are addressed linearly, texel N lives
+ * at (N % GT_DATA_TEXTURE_WIDTH, N / GT_DATA_TEXTURE_WIDTH). The first GT_DATA_TEXTURE_HEADER_TEXELS texels describe where each section of
+ * data begins and how many elements it contains so that shaders can loop over exactly the active elements.
+ */
+class GRAPHICSTOOLS_API FGTDataTexture : public FGCObject
+{
+public:
+	/** Sizes the texel array and (re)creates the texture if the number of texels has changed. Clears all texels. */
+	void Reset(int32 NumTexels);
+
+	/** Accessor to a texel, values are not sent to the GPU until Upload is called. */
+	FLinearColor& operator[](int32 TexelIndex) { return Texels[TexelIndex]; }
+
+	/** Returns the number of texels available. */
+	int32 Num() const { return Texels.Num(); }
+
+	/** Queues the texels to be copied to the texture's GPU resource the next time the world is rendered. */
+	void Upload() { bPendingUpload = true; }
+
+	/** Extrapolates the location (xyz) of the texel at TexelIndex on the render thread, just before the texels are copied to the GPU, to
+	 * the render thread's time plus PredictionTime. Used by proximity lights which follow a hand joint so that the light does not lag the
+	 * rendered hand. Predictions are cleared by Reset. */
+	void AddLocationPrediction(int32 TexelIndex, const FVector& Location, const FVector& Velocity, double SampleTime, float PredictionTime);
+
+	/** Sends any queued texels to the render thread with a single render command. Called once per rendered view family by
+	 * FGTSceneViewExtension, so multiple uploads within a frame result in a single GPU update. */
+	void Submit();
+
+	/** The furthest (in seconds) a location prediction extrapolates beyond its sample. */
+	static constexpr float MaxPredictionTime = 0.1f;
+
+	/** Accessor to the texture materials sample. */
+	UTexture2D* GetTexture() const { return Texture; }
+
+	//
+	// FGCObject interface
+
+	/** Keeps the transient texture alive. */
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+
+	/** Name used when reporting references. */
+	virtual FString GetReferencerName() const override;
+
+private:
+	/** A texel location extrapolated on the render thread, see AddLocationPrediction. */
+	struct FLocationPrediction
+	{
+		int32 TexelIndex;
+		FVector3f Location;
+		FVector3f Velocity;
+		double SampleTime;
+		float PredictionTime;
+	};
+
+	TArray<FLinearColor> Texels;
+	TArray<FLocationPrediction> LocationPredictions;
+	UTexture2D* Texture = nullptr;
+	bool bPendingUpload = false;
+};
@@ -12,7 +12,8 @@ class UArrowComponent;
 
 /**
  * A light component that has parallel rays. Will provide a uniform lighting across any affected surface (eg. The Sun). Only 1
- * DirectionalLight will be considered in a scene at a time.
+ * DirectionalLight is written to the WorldParameterCollection at a time, materials which read the data texture consider every
+ * DirectionalLight within a scene.
  */
 UCLASS(ClassGroup = (GraphicsTools), meta = (BlueprintSpawnableComponent))
 class GRAPHICSTOOLS_API UGTDirectionalLightComponent : public UGTLightComponent
@@ -38,6 +39,10 @@ public:
 	UFUNCTION(BlueprintSetter, Category = "Light")
 	void SetLightColor(FColor Color);
 
+	/** Writes the light's direction and enabled state, then color and intensity, to two consecutive values. This is the layout used by
+	 * both the WorldParameterCollection and the data texture. */
+	void PackLightData(FLinearColor* Data, bool IsDisabled = false) const;
+
 	/** Gets the material parameter name used for the direction and enabled state. */
 	UFUNCTION(BlueprintPure, Category = "Light")
 	const FName& GetDirectionEnabledParameterName() const { return DirectionEnabledParameterName; }
@@ -81,11 +86,17 @@ protected:
 	// UGTSceneComponent interface
 
 	/** Accessor to all UGTDirectionalLightComponent components within a world writing to the WorldParameterCollection. */
-	virtual TArray<UGTSceneComponent*>& GetWorldComponents() override;
+	virtual FGTComponentSlots& GetWorldComponents() override;
+
+	/** Resolves the direction and color parameter indices. */
+	virtual void CacheParameterIndices() override;
 
 	/** Updates the current parameter collection based on the current UGTDirectionalLightComponent. */
 	virtual void UpdateParameterCollection(bool IsDisabled = false) override;
 
+	/** Updates only the light's direction within the current parameter collection. */
+	virtual void UpdateParameterCollectionTransform() override;
+
 private:
 #if WITH_EDITORONLY_DATA
 	// Reference to editor visualization arrow
@@ -114,4 +125,8 @@ private:
 		EditAnywhere, Category = "Light", BlueprintGetter = "GetColorIntensityParameterName",
 		BlueprintSetter = "SetColorIntensityParameterName", AdvancedDisplay)
 	FName ColorIntensityParameterName;
+
+	/** Parameter indices resolved from the above parameter names. */
+	int32 DirectionEnabledParameterIndex = INDEX_NONE;
+	int32 ColorIntensityParameterIndex = INDEX_NONE;
 };
@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UMaterialParameterCollection;
+class UMaterialParameterCollectionInstance;
+class UWorld;
+
+/**
+ * CPU side copy of a material parameter collection's vector parameters within a world. Components resolve parameter names into indices
+ * once and then write values by index. Modified values are forwarded to the world's material parameter collection instance when the buffer
+ * is flushed. A shadow copy of the last value sent to the instance is kept so that writes which do not change a value never reach the
+ * instance (and never invalidate the collection's render state).
+ */
+class GRAPHICSTOOLS_API FGTParameterCollectionBuffer
+{
+public:
+	FGTParameterCollectionBuffer(UWorld* InWorld, const UMaterialParameterCollection* InCollection);
+
+	/** Returns the index of a vector parameter within the buffer, or INDEX_NONE if the collection does not contain the parameter. */
+	int32 FindParameterIndex(FName ParameterName) const;
+
+	/** Stages a vector parameter value which will be written to the collection instance during the next flush. */
+	FORCEINLINE void SetVectorParameterValue(int32 ParameterIndex, const FLinearColor& ParameterValue)
+	{
+		if (Values[ParameterIndex] == ParameterValue)
+		{
+			++PendingSkippedWrites;
+			return;
+		}
+
+		Values[ParameterIndex] = ParameterValue;
+		DirtyParameters[ParameterIndex] = true;
+		bDirty = true;
+	}
+
+	/** Writes all staged parameter values into the world's material parameter collection instance. */
+	void Flush();
+
+	/** The number of values sent to the collection instance during the last flush. */
+	int32 GetNumWrites() const { return NumWrites; }
+
+	/** The number of writes discarded during the last flush (and the frame leading up to it) because the value was unchanged. */
+	int32 GetNumSkippedWrites() const { return NumSkippedWrites; }
+
+	/** Accessor to the collection this buffer mirrors. */
+	const UMaterialParameterCollection* GetCollection() const { return Collection.Get(); }
+
+	/** Incremented each time the parameter layout is rebuilt, cached parameter indices are invalid when the version changes. */
+	uint32 GetVersion() const { return Version; }
+
+#if WITH_EDITOR
+	/** Returns true if the collection's parameters have been edited since the buffer was built. */
+	bool IsStale() const;
+#endif // WITH_EDITOR
+
+	/** Rebuilds the parameter layout and re-acquires the collection instance. */
+	void Rebuild();
+
+private:
+	TWeakObjectPtr<UWorld> World;
+	TWeakObjectPtr<const UMaterialParameterCollection> Collection;
+	TWeakObjectPtr<UMaterialParameterCollectionInstance> Instance;
+
+	/** Parameter names, staged values, and the values last sent to the collection instance indexed by parameter index. */
+	TArray<FName> ParameterNames;
+	TArray<FLinearColor> Values;
+	TArray<FLinearColor> UploadedValues;
+	TBitArray<> DirtyParameters;
+
+	/** The collection state the parameter layout was built from. */
+	FGuid StateId;
+	uint32 Version = 0;
+	bool bDirty = false;
+
+	int32 NumWrites = 0;
+	int32 NumSkippedWrites = 0;
+	int32 PendingSkippedWrites = 0;
+};
@@ -6,8 +6,14 @@
 #include "CoreMinimal.h"
 #include "GTLightComponent.h"
 
+#include "HeadMountedDisplayTypes.h"
+#include "InputCoreTypes.h"
+
 #include "GTProximityLightComponent.generated.h"
 
+/** The number of proximity lights which can be written to the WorldParameterCollection at once. */
+#define GT_MAX_PROXIMITY_LIGHTS 3
+
 enum class EPulseState : uint8
 {
 	Idle,
@@ -17,6 +23,8 @@ enum class EPulseState : uint8
 };
 ENUM_CLASS_FLAGS(EPulseState);
 
+class IHandTracker;
+
 /**
  * A proximity light is a Fluent Design System paradigm that acts as a surface projected gradient point light. For a material to be
  * influenced by a proximity light the ProximityLightContribution material function must be used within the material's shader graph.
@@ -26,6 +34,9 @@ class GRAPHICSTOOLS_API UGTProximityLightComponent : public UGTLightComponent
 {
 	GENERATED_BODY()
 
+	friend class FGTProximityLightPulses;
+	friend class UGTWorldSubsystem;
+
 public:
 	UGTProximityLightComponent();
 
@@ -85,6 +96,54 @@ public:
 	UFUNCTION(BlueprintSetter, Category = "Light")
 	void SetOuterColor(FColor Color);
 
+	/** Gets if the light is disabled while no proximity light surface is within reach. */
+	UFUNCTION(BlueprintGetter, Category = "Light")
+	bool GetDisableAwayFromSurfaces() const { return bDisableAwayFromSurfaces; }
+
+	/** Sets if the light is disabled while no proximity light surface is within reach. */
+	UFUNCTION(BlueprintSetter, Category = "Light")
+	void SetDisableAwayFromSurfaces(bool Disable) { bDisableAwayFromSurfaces = Disable; }
+
+	/** Returns false when the light is disabled because no proximity light surface is within reach, see bDisableAwayFromSurfaces. */
+	UFUNCTION(BlueprintPure, Category = "Light")
+	bool IsNearSurface() const { return bNearSurface; }
+
+	/** Gets if the light follows a hand tracking joint. */
+	UFUNCTION(BlueprintGetter, Category = "Hand Tracking")
+	bool GetFollowHandJoint() const { return bFollowHandJoint; }
+
+	/** Sets if the light follows a hand tracking joint. */
+	UFUNCTION(BlueprintSetter, Category = "Hand Tracking")
+	void SetFollowHandJoint(bool Follow);
+
+	/** Gets the hand the light follows. */
+	UFUNCTION(BlueprintGetter, Category = "Hand Tracking")
+	EControllerHand GetTrackedHand() const { return TrackedHand; }
+
+	/** Sets the hand the light follows. */
+	UFUNCTION(BlueprintSetter, Category = "Hand Tracking")
+	void SetTrackedHand(EControllerHand Hand);
+
+	/** Gets the hand joint the light follows. */
+	UFUNCTION(BlueprintGetter, Category = "Hand Tracking")
+	EHandKeypoint GetTrackedHandJoint() const { return TrackedHandJoint; }
+
+	/** Sets the hand joint the light follows. */
+	UFUNCTION(BlueprintSetter, Category = "Hand Tracking")
+	void SetTrackedHandJoint(EHandKeypoint Joint);
+
+	/** Gets the seconds the joint pose is extrapolated past the time the frame is rendered. */
+	UFUNCTION(BlueprintGetter, Category = "Hand Tracking")
+	float GetHandJointPredictionTime() const { return HandJointPredictionTime; }
+
+	/** Sets the seconds the joint pose is extrapolated past the time the frame is rendered. */
+	UFUNCTION(BlueprintSetter, Category = "Hand Tracking")
+	void SetHandJointPredictionTime(float Time) { HandJointPredictionTime = FMath::Max(Time, 0.0f); }
+
+	/** Returns true if the light follows a hand joint which is currently tracked. */
+	UFUNCTION(BlueprintPure, Category = "Hand Tracking")
+	bool IsHandJointTracked() const { return bHandJointTracked; }
+
 	/** Gets the material parameter name array used to represent each location of a ProximityLight. */
 	UFUNCTION(BlueprintPure, Category = "Light")
 	const TArray<FName>& GetLocationParameterNames() const { return LocationParameterNames; }
@@ -133,17 +192,33 @@ public:
 	UFUNCTION(BlueprintSetter, Category = "Light")
 	void SetOuterColorParameterNames(const TArray<FName>& Names);
 
-	/** Initiates a pulse, if one is not already occurring, which simulates a user touching a surface. */
+	/** Initiates a pulse, if one is not already occurring, which simulates a user touching a surface. The world subsystem animates the
+	 * pulse, so the light must be registered. */
 	UFUNCTION(BlueprintCallable, Category = "Light")
 	void Pulse(float Duration = 0.2f, float FadeOffset = 0.1f, float FadeDuration = 0.1f);
 
-	/** Calculates the normalized pulse animation time. */
+	/** Scores how noticeable the light is from the closest view location. Closer, brighter, and pulsing lights are more relevant. When
+	 * more than GT_MAX_PROXIMITY_LIGHTS are within a world, the most relevant lights are written to the WorldParameterCollection. */
+	float CalculateRelevance(const TArray<FVector>& ViewLocations) const;
+
+	/** Writes the light's location, settings, pulse settings, center color, middle color, and outer color (in that order) to six
+	 * consecutive values. This is the layout used by both the WorldParameterCollection and the data texture. The pulse settings carry the
+	 * influence radius (z) so that shaders can skip the light for surfaces it cannot reach. */
+	void PackLightData(FLinearColor* Data, bool IsDisabled = false) const;
+
+	/** Returns the distance from the light's location, including any pulse, beyond which the light has no effect on a surface. */
+	float GetInfluenceRadius() const;
+
+	/** Returns the WorldParameterCollection slot this light is written to, or INDEX_NONE if the light is not currently selected. */
+	int32 GetParameterCollectionSlot() const { return ParameterCollectionSlot; }
+
+	/** Returns the normalized pulse animation time. */
 	UFUNCTION(BlueprintCallable, Category = "Light")
-	float GetPulseTime() const;
+	float GetPulseTime() const { return PulseTime; }
 
-	/** Calculates the normalized pulse fade animation time. */
+	/** Returns the normalized pulse fade animation time. */
 	UFUNCTION(BlueprintCallable, Category = "Light")
-	float GetPulseFadeTime() const;
+	float GetPulseFadeTime() const { return PulseFadeTime; }
 
 protected:
 	//
@@ -157,8 +232,11 @@ protected:
 	//
 	// UActorComponent interface
 
-	/** Conditional tick method which occurs when a light needs to animate. */
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	/** Registers with the world subsystem's hand joint lights when following a hand joint. */
+	virtual void OnRegister() override;
+
+	/** Unregisters from the world subsystem's hand joint lights. */
+	virtual void OnUnregister() override;
 
 	//
 	// USceneComponent interface
@@ -172,13 +250,38 @@ protected:
 	// UGTSceneComponent interface
 
 	/** Accessor to all UGTProximityLightComponent components within a world writing to the WorldParameterCollection. */
-	virtual TArray<UGTSceneComponent*>& GetWorldComponents() override;
+	virtual FGTComponentSlots& GetWorldComponents() override;
+
+	/** Proximity lights are mapped into the WorldParameterCollection by relevance rather than by world slot, so no world slot is active. */
+	virtual int32 GetNumActiveWorldSlots() const override;
+
+	/** Releases the WorldParameterCollection slot selected for this light and stops any pulse. */
+	virtual void RemoveFromWorldParameterCollection() override;
+
+	/** Resolves the location, settings, pulse settings, and color parameter indices. */
+	virtual void CacheParameterIndices() override;
 
 	/** Updates the current parameter collection based on the current UGTProximityLightComponent. */
 	virtual void UpdateParameterCollection(bool IsDisabled = false) override;
 
+	/** Updates only the light's location within the current parameter collection. */
+	virtual void UpdateParameterCollectionTransform() override;
+
 private:
-	EPulseState PulseTick(float DeltaTime);
+	/** Updates only the pulse dependent settings within the current parameter collection. */
+	void UpdateParameterCollectionPulse();
+
+	/** Samples the followed joint from a hand tracker at Time, estimates the joint's velocity, and moves the light to the pose
+	 * extrapolated by HandJointPredictionTime. Called by the world subsystem once per frame. IHandTracker does not report when a pose was
+	 * captured, so Time is the game thread time the pose was read. Velocity is therefore subject to the jitter between the tracker and game
+	 * thread rates, which is reduced by only treating a pose which has changed as a new sample. */
+	void UpdateHandJoint(const IHandTracker* HandTracker, double Time);
+
+	/** Forgets the followed joint's last sample so that the next sample starts a new velocity estimate. */
+	void ResetHandJoint();
+
+	/** Returns the followed joint's location extrapolated to Time. */
+	FVector PredictHandJointLocation(double Time) const;
 
 	/** Specifies the radius of the ProximityLight effect when projected onto a surface. */
 	UPROPERTY(
@@ -218,6 +321,40 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintGetter = "GetOuterColor", BlueprintSetter = "SetOuterColor", Category = "Light")
 	FColor OuterColor = FColor(114, 55, 191, 255);
 
+	/** When true the light is disabled, freeing its WorldParameterCollection slot and data texture texels, while the bounds of every
+	 * UGTProximityLightSurfaceComponent's primitives are beyond the light's influence radius. Surfaces are opt in, add a
+	 * GTProximityLightSurface component to each actor whose meshes use proximity lighting materials. The light is never disabled while
+	 * the world contains no GTProximityLightSurface components. */
+	UPROPERTY(
+		EditAnywhere, Category = "Light", BlueprintGetter = "GetDisableAwayFromSurfaces", BlueprintSetter = "SetDisableAwayFromSurfaces",
+		AdvancedDisplay)
+	bool bDisableAwayFromSurfaces = false;
+
+	/** When true the light follows a joint reported by the first valid IHandTracker rather than its attachment. The joint's pose is
+	 * extrapolated to reduce the lag between the rendered hand and the light, and when the data texture is enabled the location is
+	 * extrapolated again on the render thread just before the frame's texels are uploaded. */
+	UPROPERTY(
+		EditAnywhere, Category = "Hand Tracking", BlueprintGetter = "GetFollowHandJoint", BlueprintSetter = "SetFollowHandJoint")
+	bool bFollowHandJoint = false;
+
+	/** The hand the light follows. */
+	UPROPERTY(
+		EditAnywhere, Category = "Hand Tracking", BlueprintGetter = "GetTrackedHand", BlueprintSetter = "SetTrackedHand",
+		meta = (EditCondition = "bFollowHandJoint"))
+	EControllerHand TrackedHand = EControllerHand::Right;
+
+	/** The hand joint the light follows. */
+	UPROPERTY(
+		EditAnywhere, Category = "Hand Tracking", BlueprintGetter = "GetTrackedHandJoint", BlueprintSetter = "SetTrackedHandJoint",
+		meta = (EditCondition = "bFollowHandJoint"))
+	EHandKeypoint TrackedHandJoint = EHandKeypoint::IndexTip;
+
+	/** Seconds the joint pose is extrapolated past the time the frame is rendered, approximately the time until the frame is displayed. */
+	UPROPERTY(
+		EditAnywhere, Category = "Hand Tracking", BlueprintGetter = "GetHandJointPredictionTime",
+		BlueprintSetter = "SetHandJointPredictionTime", meta = (EditCondition = "bFollowHandJoint", UIMin = "0.0", UIMax = "0.1"))
+	float HandJointPredictionTime = 0.011f;
+
 	/** Parameter name array used to represent each location of a ProximityLight to pass to a material. */
 	UPROPERTY(
 		EditAnywhere, Category = "Light", BlueprintGetter = "GetLocationParameterNames", BlueprintSetter = "SetLocationParameterNames",
@@ -254,10 +391,29 @@ private:
 		AdvancedDisplay)
 	TArray<FName> OuterColorParameterNames;
 
+	/** Parameter indices resolved from the above parameter name arrays. */
+	TArray<int32> LocationParameterIndices;
+	TArray<int32> SettingsParameterIndices;
+	TArray<int32> PulseSettingsParameterIndices;
+	TArray<int32> CenterColorParameterIndices;
+	TArray<int32> MiddleColorParameterIndices;
+	TArray<int32> OuterColorParameterIndices;
+
+	/** WorldParameterCollection slot assigned by the world subsystem, INDEX_NONE when the light is not selected. */
+	int32 ParameterCollectionSlot = INDEX_NONE;
+
+	/** Pulse state written by the world subsystem as it animates the pulse, see FGTProximityLightPulses. */
 	EPulseState PulseState = EPulseState::Idle;
-	float PulseTimer = 0;
-	float PulseFadeTimer = 0;
-	float PulseDuration = 0;
-	float PulseFadeOffset = 0;
-	float PulseFadeDuration = 0;
+	float PulseTime = 0;
+	float PulseFadeTime = 0;
+	int32 PulseIndex = INDEX_NONE;
+
+	/** Written by the world subsystem, false while bDisableAwayFromSurfaces is enabled and no surface is within reach. */
+	bool bNearSurface = true;
+
+	/** The last sample of the followed joint, see UpdateHandJoint. */
+	FVector HandJointLocation = FVector::ZeroVector;
+	FVector HandJointVelocity = FVector::ZeroVector;
+	double HandJointSampleTime = 0;
+	bool bHandJointTracked = false;
 };
@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UGTProximityLightComponent;
+enum class EPulseState : uint8;
+
+/**
+ * Every animating proximity light pulse within a world, stored as a structure of arrays so that all pulse state machines advance in a
+ * single contiguous loop rather than one component tick per light. A light is only present while its pulse is animating, finished pulses
+ * are swap removed.
+ */
+class GRAPHICSTOOLS_API FGTProximityLightPulses
+{
+public:
+	/** Starts a pulse on a light. Returns false if the light is already pulsing or the duration is not positive. */
+	bool Add(UGTProximityLightComponent* Light, float Duration, float FadeOffset, float FadeDuration);
+
+	/** Stops a light's pulse before it completes and returns the light to idle. */
+	void Remove(UGTProximityLightComponent* Light);
+
+	/** Advances every pulse by DeltaTime and writes the normalized pulse times back to each light. Every light which was animating is
+	 * added to OutUpdatedLights, including lights whose pulse completed and were removed. */
+	void Update(float DeltaTime, TArray<UGTProximityLightComponent*>& OutUpdatedLights);
+
+	/** The number of animating pulses. */
+	int32 Num() const { return Lights.Num(); }
+
+private:
+	/** Advances the pulse state machine at Index, returns the next state. */
+	EPulseState Advance(int32 Index, float DeltaTime);
+
+	/** Swap removes the pulse at Index, the light keeps its last pulse state. */
+	void RemoveAtSwap(int32 Index);
+
+	TArray<UGTProximityLightComponent*> Lights;
+	TArray<EPulseState> States;
+	TArray<float> Timers;
+	TArray<float> FadeTimers;
+	TArray<float> Durations;
+	TArray<float> FadeOffsets;
+	TArray<float> FadeDurations;
+};
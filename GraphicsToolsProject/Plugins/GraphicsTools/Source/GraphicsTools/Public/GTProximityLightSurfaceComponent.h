@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Components/ActorComponent.h"
+
+#include "GTProximityLightSurfaceComponent.generated.h"
+
+class UPrimitiveComponent;
+
+/**
+ * Opt-in component which marks its owner's primitive components as surfaces lit by proximity lights, typically primitives which use
+ * Graphics Tools materials. Proximity lights with bDisableAwayFromSurfaces enabled are disabled while no registered surface is within their
+ * reach, which frees their WorldParameterCollection slot for lights which can be seen.
+ */
+UCLASS(ClassGroup = (GraphicsTools), meta = (BlueprintSpawnableComponent))
+class GRAPHICSTOOLS_API UGTProximityLightSurfaceComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	/** Re-gathers the owner's primitive components, call after adding or removing primitive components from the owner. */
+	UFUNCTION(BlueprintCallable, Category = "Proximity Light Surface")
+	void RefreshPrimitives();
+
+	/** Accessor to the owner's primitive components gathered when the component was registered. */
+	const TArray<TWeakObjectPtr<UPrimitiveComponent>>& GetPrimitives() const { return Primitives; }
+
+protected:
+	//
+	// UActorComponent interface
+
+	/** Gathers the owner's primitives and registers with the world subsystem. */
+	virtual void OnRegister() override;
+
+	/** Unregisters from the world subsystem. */
+	virtual void OnUnregister() override;
+
+private:
+	/** The owner's primitive components. */
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> Primitives;
+};
@@ -4,11 +4,14 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GTComponentSlots.h"
 
 #include "Components/SceneComponent.h"
 
 #include "GTSceneComponent.generated.h"
 
+class FGTParameterCollectionBuffer;
+class UGTWorldSubsystem;
 class UMaterialParameterCollection;
 
 /**
@@ -19,6 +22,8 @@ class GRAPHICSTOOLS_API UGTSceneComponent : public USceneComponent
 {
 	GENERATED_BODY()
 
+	friend class UGTWorldSubsystem;
+
 public:
 	UGTSceneComponent();
 
@@ -47,35 +52,70 @@ protected:
 	//
 	// USceneComponent interface
 
-	/** Updates the parameter collection when the transform changes. */
+	/** Marks the parameter collection dirty when the transform changes. */
 	virtual void OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport = ETeleportType::None) override;
 
 #if WITH_EDITOR
-	/** Updates the material parameter collection. */
+	/** Removes the component from the world list before the parameter collection override changes. */
+	virtual void PreEditChange(FProperty* PropertyAboutToChange) override;
+
+	/** Marks the material parameter collection dirty. */
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 #endif // WITH_EDITOR
 
 	/** Returns true if the scene belongs to a world and has a material parameter collection. */
 	virtual bool IsValid() const;
 
+	/** Accessor to the subsystem of the world the component is registered to, null when the component is not registered. */
+	UGTWorldSubsystem* GetWorldSubsystem() const { return WorldSubsystem; }
+
 	/** Const accessor to the current material parameter collection in use. */
 	const UMaterialParameterCollection* GetParameterCollection() const;
 
-	/** Sets a vector value on the current material parameter collection, returns true if successful. */
-	bool SetVectorParameterValue(FName ParameterName, const FLinearColor& ParameterValue);
+	/** Returns the index of a vector parameter within the current material parameter collection, or INDEX_NONE if it does not exist. */
+	int32 FindParameterIndex(FName ParameterName) const;
+
+	/** Resolves an array of parameter names into indices within the current material parameter collection. */
+	void FindParameterIndices(const TArray<FName>& ParameterNames, TArray<int32>& OutParameterIndices) const;
+
+	/** Resolves all parameter names used by the component into indices within the current material parameter collection. Called when the
+	 * component registers and whenever the parameter collection or parameter names change. */
+	virtual void CacheParameterIndices() {}
+
+	/** Sets a vector value on the current material parameter collection by a previously resolved index, returns true if successful. */
+	bool SetVectorParameterValue(int32 ParameterIndex, const FLinearColor& ParameterValue);
 
 	/** Adds this component to a list which will be processed when writing to the WorldParameterCollection. */
 	void AddToWorldParameterCollection();
 
 	/** Removes this component from a list which will be processed when writing to the WorldParameterCollection. */
-	void RemoveFromWorldParameterCollection();
+	virtual void RemoveFromWorldParameterCollection();
+
+	/** Requests that the world subsystem calls UpdateParameterCollection on this component before the end of the frame. Multiple requests
+	 * within a frame result in a single update. */
+	void MarkParameterCollectionDirty();
+
+	/** Requests that the world subsystem calls UpdateParameterCollectionTransform on this component before the end of the frame. Used when
+	 * only the component's transform has changed, a component attached to an animated hierarchy is only updated once per frame using its
+	 * final transform regardless of how many of its parents moved. */
+	void MarkParameterCollectionTransformDirty();
 
-	/** Pure virtual accessor to all components of a specific type within a world writing to the WorldParameterCollection. */
-	virtual TArray<UGTSceneComponent*>& GetWorldComponents() PURE_VIRTUAL(UGTSceneComponent::UpdateParameterCollection, return Empty;);
+	/** Pure virtual accessor to the slots of all components of a specific type within a world writing to the WorldParameterCollection. */
+	virtual FGTComponentSlots& GetWorldComponents() PURE_VIRTUAL(UGTSceneComponent::GetWorldComponents, return Empty;);
+
+	/** The number of slots, starting at slot zero, which are written to the WorldParameterCollection for this component type. */
+	virtual int32 GetNumActiveWorldSlots() const { return 1; }
+
+	/** Returns the slot this component occupies within GetWorldComponents, or INDEX_NONE if it is not writing to the
+	 * WorldParameterCollection. */
+	int32 GetWorldSlotIndex() const { return WorldSlotIndex; }
 
 	/** Pure virtual method that updates the parameter collection based on the current type. */
 	virtual void UpdateParameterCollection(bool IsDisabled = false) PURE_VIRTUAL(UGTSceneComponent::UpdateParameterCollection, );
 
+	/** Updates only the transform dependent state within the parameter collection. By default all state is updated. */
+	virtual void UpdateParameterCollectionTransform() { UpdateParameterCollection(); }
+
 #if WITH_EDITORONLY_DATA
 	/** Sprite for the scene in the editor. */
 	UPROPERTY(transient)
@@ -96,6 +136,25 @@ private:
 	UPROPERTY(Transient)
 	UMaterialParameterCollection* WorldParameterCollection = nullptr;
 
-	/** Empty component list which is used by the pure virtual GetWorldComponents method. */
-	static TArray<UGTSceneComponent*> Empty;
+	/** Subsystem of the world the component is registered to, null when the component is not registered. */
+	UPROPERTY(Transient)
+	UGTWorldSubsystem* WorldSubsystem = nullptr;
+
+	/** Caches the world subsystem's buffer for the current material parameter collection and resolves all parameter indices. */
+	void CacheParameterCollection();
+
+	/** Re-resolves parameter indices if the current material parameter collection's layout changed since they were cached. */
+	void ValidateParameterCache();
+
+	/** Staging buffer for the current material parameter collection. */
+	TSharedPtr<FGTParameterCollectionBuffer> ParameterCollectionBuffer;
+
+	/** The buffer version parameter indices were resolved against. */
+	uint32 ParameterCollectionBufferVersion = 0;
+
+	/** Slot within GetWorldComponents, INDEX_NONE when not writing to the WorldParameterCollection. */
+	int32 WorldSlotIndex = INDEX_NONE;
+
+	/** Empty component slots which are used by the pure virtual GetWorldComponents method. */
+	static FGTComponentSlots Empty;
 };
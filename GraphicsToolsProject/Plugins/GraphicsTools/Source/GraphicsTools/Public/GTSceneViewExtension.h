@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SceneViewExtension.h"
+
+class FGTDataTexture;
+
+/**
+ * Scene view extension which sends the state packed by a world's UGTWorldSubsystem to the render thread once per rendered frame. All
+ * changes made to lights and clipping primitives during a frame reach the GPU with a single render command, regardless of how many
+ * components changed or how many times the state was repacked.
+ */
+class GRAPHICSTOOLS_API FGTSceneViewExtension : public FWorldSceneViewExtension
+{
+public:
+	FGTSceneViewExtension(const FAutoRegister& AutoRegister, UWorld* InWorld, const TSharedPtr<FGTDataTexture>& InDataTexture);
+
+	//
+	// ISceneViewExtension interface
+
+	virtual void SetupViewFamily(FSceneViewFamily& InViewFamily) override {}
+	virtual void SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView) override {}
+
+	/** Submits the data texture, if it has changed, before the view family is rendered. */
+	virtual void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override;
+
+private:
+	TWeakPtr<FGTDataTexture> DataTexture;
+};
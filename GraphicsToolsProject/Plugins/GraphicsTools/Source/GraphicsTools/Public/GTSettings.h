@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Engine/DeveloperSettings.h"
+
+#include "GTSettings.generated.h"
+
+/** How multiple clipping primitives of the same type are combined within the data texture. */
+UENUM()
+enum class EGTClippingPrimitiveCombineMode : uint8
+{
+	/** A pixel is clipped when any primitive clips it (the minimum signed distance). */
+	Union,
+	/** A pixel is clipped only when every primitive clips it (the maximum signed distance). */
+	Intersection
+};
+
+/**
+ * Project wide Graphics Tools settings, found under Project Settings > Plugins > Graphics Tools.
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Graphics Tools"))
+class GRAPHICSTOOLS_API UGTSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UGTSettings();
+
+	/** When enabled, each world packs the state of all Graphics Tools lights and clipping primitives into a data texture once per frame.
+	 * Materials which sample the data texture are not limited to the lights and primitives which fit within the MPC_GTSettings material
+	 * parameter collection. */
+	UPROPERTY(Config, EditAnywhere, Category = "Data Texture")
+	bool bEnableDataTexture = false;
+
+	/** The maximum number of proximity lights which are written to the data texture. */
+	UPROPERTY(Config, EditAnywhere, Category = "Data Texture", meta = (EditCondition = "bEnableDataTexture", ClampMin = "1", ClampMax = "1024"))
+	int32 MaxDataTextureProximityLights = 64;
+
+	/** When enabled, proximity lights are binned into a world space grid of clusters centered on the view. Materials which use
+	 * GTContributionProximityLightsClustered only evaluate the lights which can reach the cluster a pixel is within. */
+	UPROPERTY(Config, EditAnywhere, Category = "Data Texture", meta = (EditCondition = "bEnableDataTexture"))
+	bool bEnableProximityLightClusters = false;
+
+	/** The size of a single cluster cell in world units. */
+	UPROPERTY(
+		Config, EditAnywhere, Category = "Data Texture",
+		meta = (EditCondition = "bEnableDataTexture && bEnableProximityLightClusters", ClampMin = "1.0", Units = "cm"))
+	float ProximityLightClusterSize = 20.0f;
+
+	/** The number of cluster cells along each axis of the grid. Pixels outside of the grid evaluate all proximity lights. */
+	UPROPERTY(
+		Config, EditAnywhere, Category = "Data Texture",
+		meta = (EditCondition = "bEnableDataTexture && bEnableProximityLightClusters", ClampMin = "1", ClampMax = "32"))
+	int32 ProximityLightClusterGridSize = 16;
+
+	/** The maximum number of light references across all clusters. Clusters which do not fit evaluate all proximity lights. */
+	UPROPERTY(
+		Config, EditAnywhere, Category = "Data Texture",
+		meta = (EditCondition = "bEnableDataTexture && bEnableProximityLightClusters", ClampMin = "4", ClampMax = "65536"))
+	int32 MaxProximityLightClusterIndices = 4096;
+
+	/** The maximum number of clipping primitives of each type (plane, sphere, box, and cone) which are written to the data texture. Larger
+	 * values allow more primitives at the cost of a larger texture, per pixel cost only depends on the number of active primitives. */
+	UPROPERTY(Config, EditAnywhere, Category = "Data Texture", meta = (EditCondition = "bEnableDataTexture", ClampMin = "1", ClampMax = "1024"))
+	int32 MaxDataTextureClippingPrimitives = 16;
+
+	/** How the signed distances of multiple clipping primitives of the same type are combined. */
+	UPROPERTY(Config, EditAnywhere, Category = "Data Texture", meta = (EditCondition = "bEnableDataTexture"))
+	EGTClippingPrimitiveCombineMode ClippingPrimitiveCombineMode = EGTClippingPrimitiveCombineMode::Union;
+
+	/** The size in world units of each cell of the grid used to find the proximity light surfaces near proximity lights which are disabled
+	 * away from surfaces. Roughly the size of a typical surface works well. */
+	UPROPERTY(Config, EditAnywhere, Category = "Proximity Lights", meta = (ClampMin = "1.0", Units = "cm"))
+	float ProximityLightSurfaceCellSize = 50.0f;
+
+	/** The maximum number of GTClippingCullingComponents each world updates per frame. Components are updated round robin, so with more
+	 * components than this each component is updated every few frames. */
+	UPROPERTY(Config, EditAnywhere, Category = "Clipping Culling", meta = (ClampMin = "1"))
+	int32 ClippingCullingComponentsPerFrame = 32;
+};
@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A sparse world space grid of surface bounds used to quickly find if any surface is near a point. Each surface is referenced by every
+ * cell its bounds overlap, surfaces which overlap too many cells are kept in a separate list which every query tests. The grid is cheap
+ * to rebuild, so it is rebuilt whenever the surfaces may have moved rather than updated in place.
+ */
+class GRAPHICSTOOLS_API FGTSurfaceGrid
+{
+public:
+	/** Removes all surfaces and sets the size of each cell in world units. */
+	void Reset(float InCellSize);
+
+	/** Adds the bounds of a surface to the grid. */
+	void Add(const FBox& Bounds);
+
+	/** Returns true if any surface's bounds intersect the sphere. */
+	bool Intersects(const FSphere& Sphere) const;
+
+	/** The number of surfaces within the grid. */
+	int32 Num() const { return Surfaces.Num(); }
+
+private:
+	/** Returns the range of cells a box overlaps. */
+	void CalculateCellRange(const FBox& Bounds, FIntVector& Min, FIntVector& Max) const;
+
+	/** The bounds of every surface. */
+	TArray<FBox> Surfaces;
+
+	/** Surface indices referenced by each occupied cell. */
+	TMap<FIntVector, TArray<int32>> Cells;
+
+	/** Indices of surfaces which overlap too many cells to be referenced by each one. */
+	TArray<int32> LargeSurfaces;
+
+	float CellSize = 1;
+};
@@ -4,41 +4,266 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GTComponentSlots.h"
+#include "GTProximityLightPulses.h"
+#include "GTSurfaceGrid.h"
 
 #include "Subsystems/WorldSubsystem.h"
 
 #include "GTWorldSubsystem.generated.h"
 
+class FGTDataTexture;
+class FGTParameterCollectionBuffer;
+class FGTSceneViewExtension;
+class UGTClippingCullingComponent;
+class UGTProximityLightComponent;
+class UGTProximityLightSurfaceComponent;
 class UGTSceneComponent;
+class UMaterialInstanceDynamic;
+class UMaterialParameterCollection;
+class UTexture2D;
 
 /**
  * Subsystem to hold all graphics data associated with a world that will effect the world's MPC_GTSettings material parameter collection.
+ * Components do not write to their material parameter collection directly, instead they mark themselves dirty and the subsystem flushes
+ * all dirty state once per frame after all actors and components have ticked.
  */
 UCLASS(ClassGroup = GraphicsTools)
-class GRAPHICSTOOLS_API UGTWorldSubsystem : public UWorldSubsystem
+class GRAPHICSTOOLS_API UGTWorldSubsystem : public UTickableWorldSubsystem
 {
 	GENERATED_BODY()
 
 public:
-	/** List of all DirectionalLights within a world. */
-	TArray<UGTSceneComponent*> DirectionalLights;
+	/** Queues a component to write its state into its material parameter collection during the next flush. */
+	void MarkComponentDirty(UGTSceneComponent* Component);
 
-	/** List of all ProximityLights within a world. */
-	TArray<UGTSceneComponent*> ProximityLights;
+	/** Queues a component to write only its transform dependent state during the next flush. Has no effect if the component is already
+	 * queued to write all of its state. */
+	void MarkComponentTransformDirty(UGTSceneComponent* Component);
 
-	/** List of all ClippingPlanes within a world. */
-	TArray<UGTSceneComponent*> ClippingPlanes;
+	/** Removes a component from the queue of components waiting to be flushed. */
+	void ClearComponentDirty(UGTSceneComponent* Component);
 
-	/** List of all ClippingSpheres within a world. */
-	TArray<UGTSceneComponent*> ClippingSpheres;
+	/** Writes the state of all dirty components into their material parameter collections. */
+	void FlushDirtyComponents();
 
-	/** List of all ClippingBoxes within a world. */
-	TArray<UGTSceneComponent*> ClippingBoxes;
+	/** Returns the texture which holds the packed state of all lights within the world, or null if the data texture is disabled within
+	 * the Graphics Tools project settings. The texture is recreated when the data texture settings change size, prefer BindDataTexture
+	 * which keeps materials bound to the current texture. */
+	UFUNCTION(BlueprintPure, Category = "Graphics Tools")
+	UTexture2D* GetDataTexture() const;
 
-	/** List of all ClippingCones within a world. */
-	TArray<UGTSceneComponent*> ClippingCones;
+	/** Assigns the data texture to the GTDataTexture texture parameter of a material instance. The material is re-bound whenever the
+	 * data texture is recreated. */
+	UFUNCTION(BlueprintCallable, Category = "Graphics Tools")
+	void BindDataTexture(UMaterialInstanceDynamic* Material);
+
+	/** Requests that the data texture is repacked during the next flush. */
+	void MarkDataTextureDirty() { bDataTextureDirty = true; }
+
+	/** Adds a component to the set of components whose primitives are culled against the world's clipping primitives. */
+	void AddClippingCullingComponent(UGTClippingCullingComponent* Component);
+
+	/** Removes a component from the set of components whose primitives are culled against the world's clipping primitives. */
+	void RemoveClippingCullingComponent(UGTClippingCullingComponent* Component);
+
+	/** Frees the WorldParameterCollection slot selected for a proximity light so another light can be selected. */
+	void ReleaseProximityLightSlot(UGTProximityLightComponent* Light);
+
+	/** Starts animating a pulse on a proximity light, has no effect if the light is already pulsing. */
+	void StartProximityLightPulse(UGTProximityLightComponent* Light, float Duration, float FadeOffset, float FadeDuration);
+
+	/** Stops a proximity light's pulse before it completes. */
+	void StopProximityLightPulse(UGTProximityLightComponent* Light);
+
+	/** Adds a proximity light to the set of lights which follow a hand tracking joint. */
+	void AddHandJointLight(UGTProximityLightComponent* Light);
+
+	/** Removes a proximity light from the set of lights which follow a hand tracking joint. */
+	void RemoveHandJointLight(UGTProximityLightComponent* Light);
+
+	/** Adds a component whose primitives are surfaces proximity lights are tested against, see bDisableAwayFromSurfaces. */
+	void AddProximityLightSurface(UGTProximityLightSurfaceComponent* Surface);
+
+	/** Removes a component whose primitives are surfaces proximity lights are tested against. */
+	void RemoveProximityLightSurface(UGTProximityLightSurfaceComponent* Surface);
+
+	/** The number of values written to material parameter collection instances during the last flush. */
+	int32 GetNumParameterWrites() const { return NumParameterWrites; }
+
+	/** The number of material parameter collection writes discarded during the last flush because the value was unchanged. */
+	int32 GetNumSkippedParameterWrites() const { return NumSkippedParameterWrites; }
+
+	/** The number of clipping primitive transform updates skipped during the last flush because the transform was unchanged. */
+	int32 GetNumSkippedTransformUpdates() const { return NumSkippedTransformUpdates; }
+
+	/** Records a clipping primitive transform update which was skipped because the transform was unchanged. */
+	void AddSkippedTransformUpdate() { ++NumSkippedTransformUpdates; }
+
+	/** Returns the buffer which stages writes to a material parameter collection within this world, one is created if it does not exist. */
+	TSharedPtr<FGTParameterCollectionBuffer> FindOrAddParameterCollectionBuffer(const UMaterialParameterCollection* Collection);
+
+	/** Slots of all DirectionalLights within a world. */
+	FGTComponentSlots DirectionalLights;
+
+	/** Slots of all ProximityLights within a world. */
+	FGTComponentSlots ProximityLights;
+
+	/** Slots of all ClippingPlanes within a world. */
+	FGTComponentSlots ClippingPlanes;
+
+	/** Slots of all ClippingSpheres within a world. */
+	FGTComponentSlots ClippingSpheres;
+
+	/** Slots of all ClippingBoxes within a world. */
+	FGTComponentSlots ClippingBoxes;
+
+	/** Slots of all ClippingCones within a world. */
+	FGTComponentSlots ClippingCones;
 
 protected:
+	//
+	// USubsystem interface
+
+	/** Sizes the proximity light slot table and creates the data texture when enabled. */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Releases any pending dirty components and parameter collection buffers. */
+	virtual void Deinitialize() override;
+
+	//
+	// UWorldSubsystem interface
+
 	/** Allows editor preview worlds to have this subsystem. */
 	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+	//
+	// FTickableGameObject interface
+
+	/** Moves hand joint lights, animates proximity light pulses, flushes all dirty components, and culls primitives against clipping
+	 * primitives once per frame. */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Editor worlds need to flush state so that changes are visible while editing. */
+	virtual bool IsTickableInEditor() const override { return true; }
+
+	/** Components can still be altered while the game is paused. */
+	virtual bool IsTickableWhenPaused() const override { return true; }
+
+	/** Stat used to track the subsystem's tick time. */
+	virtual TStatId GetStatId() const override;
+
+private:
+#if WITH_EDITOR
+	/** Rebuilds the layout of any parameter collection buffers whose collection has been edited. */
+	void RebuildStaleParameterCollectionBuffers();
+#endif // WITH_EDITOR
+
+	/** Tests each proximity light which is disabled away from surfaces against the bounds of every proximity light surface. */
+	void UpdateProximityLightSurfaces();
+
+	/** Selects the most relevant proximity lights and maps them into the WorldParameterCollection slots. Lights keep their slot while
+	 * they remain selected so that lights do not swap slots from frame to frame. Lights away from surfaces are never selected. */
+	void SelectProximityLights();
+
+	/** Samples the joint of every hand joint light from the first valid hand tracker and moves the lights to their predicted pose. */
+	void UpdateHandJointLights();
+
+	/** Advances every proximity light pulse and queues the pulsing lights to write their pulse settings during the next flush. */
+	void UpdateProximityLightPulses(float DeltaTime);
+
+	/** Updates the next ClippingCullingComponentsPerFrame clipping culling components. */
+	void UpdateClippingCulling();
+
+	/** Reports per frame write and component counts to the GraphicsTools stat group and trace counters. */
+	void UpdateStats() const;
+
+	/** Packs all world lights into the data texture and uploads it. */
+	void UpdateDataTexture();
+
+	/** Returns a world space sphere (center, radius) enclosing the influence of every proximity light packed into the data texture. */
+	FLinearColor CalculateProximityLightSetBounds() const;
+
+	/** Packs up to MaxDataTextureClippingPrimitives of a single clipping primitive type into the data texture, returns the texel after
+	 * the last texel reserved for the type. */
+	int32 PackClippingPrimitives(const FGTComponentSlots& Primitives, int32 HeaderIndex, int32 TexelsPerPrimitive, int32 TexelIndex);
+
+	/** Packs every directional light into the data texture, the two strongest lights in full and the rest collapsed. Returns the texel
+	 * after the directional light section. */
+	int32 PackDirectionalLights(int32 TexelIndex);
+
+	/** Bins the proximity lights packed into the data texture into a world space grid of clusters. */
+	void PackProximityLightClusters(int32 TexelIndex);
+
+	/** Returns the origin of the cluster grid, which follows the first view in cell sized steps. */
+	FVector CalculateClusterOrigin() const;
+
+	/** Components which need to write their state during the next flush. */
+	TSet<UGTSceneComponent*> DirtyComponents;
+
+	/** Components which need to write their transform dependent state during the next flush. */
+	TSet<UGTSceneComponent*> DirtyTransformComponents;
+
+	/** The proximity light written to each WorldParameterCollection slot, null when a slot is unused. */
+	TArray<UGTProximityLightComponent*, TInlineAllocator<4>> ProximityLightSlots;
+
+	/** Every animating proximity light pulse. */
+	FGTProximityLightPulses ProximityLightPulses;
+
+	/** Proximity lights which need to write their pulse settings during the next flush. */
+	TArray<UGTProximityLightComponent*> PulsedProximityLights;
+
+	/** Proximity lights which follow a hand tracking joint. */
+	TArray<UGTProximityLightComponent*> HandJointLights;
+
+	/** Components whose primitives are surfaces proximity lights are tested against. */
+	TArray<UGTProximityLightSurfaceComponent*> ProximityLightSurfaces;
+
+	/** Spatial index of the bounds of every proximity light surface primitive, rebuilt each flush while any light needs it. */
+	FGTSurfaceGrid SurfaceGrid;
+
+	/** The number of proximity lights disabled during the last flush because no surface was within reach. */
+	int32 NumProximityLightsAwayFromSurfaces = 0;
+
+	/** True once the missing proximity light surfaces warning has been logged for this world. */
+	bool bWarnedNoProximityLightSurfaces = false;
+
+	/** Scratch array of proximity lights and their relevance reused by SelectProximityLights. */
+	TArray<TPair<UGTProximityLightComponent*, float>> ProximityLightCandidates;
+
+	/** Packed light state, only valid when the data texture is enabled. */
+	TSharedPtr<FGTDataTexture> DataTexture;
+
+	/** Materials passed to BindDataTexture, re-bound when the data texture is recreated. */
+	TArray<TWeakObjectPtr<UMaterialInstanceDynamic>> DataTextureMaterials;
+
+	/** Scratch array of the bounds of each proximity light packed into the data texture. */
+	TArray<FSphere> ProximityLightBounds;
+
+	/** Scratch arrays of the light count and first light index of each cluster. */
+	TArray<int32> ClusterCounts;
+	TArray<int32> ClusterOffsets;
+
+	/** Origin of the cluster grid when the data texture was last packed. */
+	FVector ClusterOrigin = FVector::ZeroVector;
+
+	/** Sends the data texture to the render thread once per rendered frame. */
+	TSharedPtr<FGTSceneViewExtension, ESPMode::ThreadSafe> SceneViewExtension;
+
+	/** True when a light has changed since the data texture was last uploaded. */
+	bool bDataTextureDirty = true;
+
+	/** Write counts from the last flush. */
+	int32 NumParameterWrites = 0;
+	int32 NumSkippedParameterWrites = 0;
+	int32 NumSkippedTransformUpdates = 0;
+
+	/** Components whose primitives are culled against the world's clipping primitives, updated round robin. */
+	TArray<UGTClippingCullingComponent*> ClippingCullingComponents;
+
+	/** The next clipping culling component to update. */
+	int32 ClippingCullingIndex = 0;
+
+	/** Staging buffers for each material parameter collection written to within this world. */
+	TMap<TObjectKey<UMaterialParameterCollection>, TSharedPtr<FGTParameterCollectionBuffer>> ParameterCollectionBuffers;
 };
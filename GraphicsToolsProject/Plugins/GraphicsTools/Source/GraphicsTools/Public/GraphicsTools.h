@@ -6,9 +6,53 @@
 #include "CoreMinimal.h"
 
 #include "Modules/ModuleManager.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(GraphicsTools, All, All)
 
+/** Insights trace channel for Graphics Tools events, enable with -trace=cpu,GraphicsTools. */
+UE_TRACE_CHANNEL_EXTERN(GraphicsToolsChannel, GRAPHICSTOOLS_API)
+
+/** Stat group viewable with "stat GraphicsTools". */
+DECLARE_STATS_GROUP(TEXT("GraphicsTools"), STATGROUP_GraphicsTools, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Flush Dirty Components"), STAT_GTFlushDirtyComponents, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Select Proximity Lights"), STAT_GTSelectProximityLights, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Data Texture"), STAT_GTUpdateDataTexture, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Flush Parameter Collections"), STAT_GTFlushParameterCollections, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Directional Light"), STAT_GTUpdateDirectionalLight, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Proximity Light"), STAT_GTUpdateProximityLight, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Proximity Light Pulses"), STAT_GTUpdateProximityLightPulses, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Hand Joint Lights"), STAT_GTUpdateHandJointLights, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Proximity Light Surfaces"), STAT_GTUpdateProximityLightSurfaces, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Clipping Primitive"), STAT_GTUpdateClippingPrimitive, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Clipping Culling"), STAT_GTUpdateClippingCulling, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Mesh Outline Material"), STAT_GTUpdateMeshOutlineMaterial, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Visual Profiler Tick"), STAT_GTVisualProfilerTick, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("MPC Writes"), STAT_GTParameterWrites, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("MPC Skipped Writes"), STAT_GTSkippedParameterWrites, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Skipped Transform Updates"), STAT_GTSkippedTransformUpdates, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Directional Lights"), STAT_GTDirectionalLights, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Directional Lights (Active)"), STAT_GTActiveDirectionalLights, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Proximity Lights"), STAT_GTProximityLights, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Proximity Lights (Active)"), STAT_GTActiveProximityLights, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Proximity Lights (Away From Surfaces)"), STAT_GTProximityLightsAwayFromSurfaces, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Clipping Planes"), STAT_GTClippingPlanes, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Clipping Planes (Active)"), STAT_GTActiveClippingPlanes, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Clipping Spheres"), STAT_GTClippingSpheres, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Clipping Spheres (Active)"), STAT_GTActiveClippingSpheres, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Clipping Boxes"), STAT_GTClippingBoxes, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Clipping Boxes (Active)"), STAT_GTActiveClippingBoxes, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Clipping Cones"), STAT_GTClippingCones, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Clipping Cones (Active)"), STAT_GTActiveClippingCones, STATGROUP_GraphicsTools, GRAPHICSTOOLS_API);
+
+/** Scopes a GraphicsTools cycle stat along with an Insights CPU event on the GraphicsTools trace channel. */
+#define GT_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat);       \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, GraphicsToolsChannel)
+
 /**
  * Entry and exit point for the primary Graphics Tools module.
  */
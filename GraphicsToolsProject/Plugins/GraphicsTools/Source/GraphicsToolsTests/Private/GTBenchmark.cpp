@@ -0,0 +1,287 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "GTClippingBoxComponent.h"
+#include "GTClippingConeComponent.h"
+#include "GTClippingFunctionLibrary.h"
+#include "GTClippingPlaneComponent.h"
+#include "GTClippingSphereComponent.h"
+#include "GTProximityLightComponent.h"
+#include "GTWorldSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+static TAutoConsoleVariable<float> CVarBenchmarkFrameBudget(
+	TEXT("GraphicsTools.Benchmark.FrameBudgetMs"), 2.0f,
+	TEXT("Average milliseconds per frame GraphicsTools.Benchmark may spend updating and flushing components before it reports a failure."));
+
+static TAutoConsoleVariable<int32> CVarBenchmarkWriteBudget(
+	TEXT("GraphicsTools.Benchmark.WriteBudget"), 256,
+	TEXT("Average material parameter collection writes per frame GraphicsTools.Benchmark may make before it reports a failure."));
+
+namespace GTBenchmark
+{
+	template <typename T>
+	void AddComponents(AActor* Owner, int32 Count, TArray<UGTSceneComponent*>& Components)
+	{
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			T* Component = NewObject<T>(Owner, NAME_None, RF_Transient);
+			Component->SetupAttachment(Owner->GetRootComponent());
+			Component->RegisterComponent();
+			Components.Add(Component);
+		}
+	}
+
+	/**
+	 * Spawns proximity lights and clipping primitives into a world and moves, hides, unregisters and re-registers a fraction of them each
+	 * frame. The time spent altering components and flushing the world subsystem is compared against the GraphicsTools.Benchmark budgets,
+	 * and every clipping primitive given a redundant transform update must skip re-uploading it, so that scaling regressions can be caught
+	 * in headless runs by the GraphicsTools.Benchmark automation test. Returns true if the run is within every budget.
+	 */
+	bool Run(UWorld* World, int32 NumLights, int32 NumPrimitives, int32 NumFrames, FOutputDevice& Ar)
+	{
+		UGTWorldSubsystem* Subsystem = World ? World->GetSubsystem<UGTWorldSubsystem>() : nullptr;
+
+		if (Subsystem == nullptr)
+		{
+			Ar.Logf(ELogVerbosity::Error, TEXT("GraphicsTools.Benchmark requires a world with a GTWorldSubsystem."));
+			return false;
+		}
+
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+		AActor* Owner = World->SpawnActor<AActor>(SpawnParameters);
+		Owner->SetRootComponent(NewObject<USceneComponent>(Owner, NAME_None, RF_Transient));
+		Owner->GetRootComponent()->RegisterComponent();
+
+		TArray<UGTSceneComponent*> Components;
+		const double RegisterStart = FPlatformTime::Seconds();
+
+		AddComponents<UGTProximityLightComponent>(Owner, NumLights, Components);
+		AddComponents<UGTClippingPlaneComponent>(Owner, NumPrimitives / 4, Components);
+		AddComponents<UGTClippingSphereComponent>(Owner, NumPrimitives / 4, Components);
+		AddComponents<UGTClippingBoxComponent>(Owner, NumPrimitives / 4, Components);
+		AddComponents<UGTClippingConeComponent>(Owner, NumPrimitives - (NumPrimitives / 4) * 3, Components);
+		Subsystem->FlushDirtyComponents();
+
+		const double RegisterTime = FPlatformTime::Seconds() - RegisterStart;
+
+		FRandomStream Random(0);
+		double FrameTime = 0;
+		double MaxFrameTime = 0;
+		int64 NumWrites = 0;
+		int64 NumSkippedWrites = 0;
+		int64 NumSkippedTransformUpdates = 0;
+		int64 NumRedundantTransformUpdates = 0;
+
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const double FrameStart = FPlatformTime::Seconds();
+
+			for (int32 Index = 0; Index < Components.Num(); ++Index)
+			{
+				UGTSceneComponent* Component = Components[Index];
+
+				// Every other component moves and the rest receive a redundant transform update (as happens when a parent is
+				// re-attached), every 16th toggles visibility, and every 32nd re-registers.
+				if ((Index + Frame) % 2 == 0)
+				{
+					Component->SetRelativeLocation(Random.GetUnitVector() * 1000.0f);
+				}
+				else
+				{
+					Component->UpdateComponentToWorld(EUpdateTransformFlags::None, ETeleportType::None);
+
+					// Clipping primitives which did not move must skip re-uploading their transform.
+					if (Component->IsA<UGTClippingPrimitiveComponent>() && Component->IsRegistered())
+					{
+						++NumRedundantTransformUpdates;
+					}
+				}
+
+				if ((Index + Frame) % 16 == 0)
+				{
+					Component->SetVisibility(!Component->IsVisible());
+				}
+
+				if ((Index + Frame) % 32 == 0)
+				{
+					Component->UnregisterComponent();
+					Component->RegisterComponent();
+				}
+			}
+
+			Subsystem->FlushDirtyComponents();
+
+			const double Elapsed = FPlatformTime::Seconds() - FrameStart;
+			FrameTime += Elapsed;
+			MaxFrameTime = FMath::Max(MaxFrameTime, Elapsed);
+			NumWrites += Subsystem->GetNumParameterWrites();
+			NumSkippedWrites += Subsystem->GetNumSkippedParameterWrites();
+			NumSkippedTransformUpdates += Subsystem->GetNumSkippedTransformUpdates();
+		}
+
+		for (UGTSceneComponent* Component : Components)
+		{
+			Component->DestroyComponent();
+		}
+
+		Owner->Destroy();
+		Subsystem->FlushDirtyComponents();
+
+		const double AverageFrameMs = (FrameTime / NumFrames) * 1000.0;
+		const double AverageWrites = static_cast<double>(NumWrites) / NumFrames;
+		const double FrameBudget = CVarBenchmarkFrameBudget.GetValueOnGameThread();
+		const int32 WriteBudget = CVarBenchmarkWriteBudget.GetValueOnGameThread();
+		const bool Passed = AverageFrameMs <= FrameBudget && AverageWrites <= WriteBudget &&
+			NumSkippedTransformUpdates >= NumRedundantTransformUpdates;
+
+		Ar.Logf(
+			Passed ? ELogVerbosity::Display : ELogVerbosity::Error,
+			TEXT("GraphicsTools.Benchmark %s: %d lights, %d clipping primitives, %d frames. Register %.2fms, ")
+				TEXT("frame avg %.3fms (budget %.3fms) max %.3fms, MPC writes avg %.1f (budget %d) skipped avg %.1f, ")
+				TEXT("skipped clipping transform updates avg %.1f (expected at least %.1f)."),
+			Passed ? TEXT("passed") : TEXT("failed"), NumLights, NumPrimitives, NumFrames, RegisterTime * 1000.0, AverageFrameMs,
+			FrameBudget, MaxFrameTime * 1000.0, AverageWrites, WriteBudget, static_cast<double>(NumSkippedWrites) / NumFrames,
+			static_cast<double>(NumSkippedTransformUpdates) / NumFrames, static_cast<double>(NumRedundantTransformUpdates) / NumFrames);
+
+		return Passed;
+	}
+
+	/** Runs the benchmark from the console arguments [NumProximityLights] [NumClippingPrimitives] [NumFrames]. */
+	void RunCommand(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const int32 NumLights = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 0) : 1024;
+		const int32 NumPrimitives = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 0) : 1024;
+		const int32 NumFrames = Args.Num() > 2 ? FMath::Max(FCString::Atoi(*Args[2]), 1) : 60;
+
+		Run(World, NumLights, NumPrimitives, NumFrames, Ar);
+	}
+
+	/** Times a function over a number of iterations, returns the average milliseconds per iteration. */
+	template <typename Func>
+	double Time(int32 NumIterations, Func Function)
+	{
+		const double Start = FPlatformTime::Seconds();
+
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			Function();
+		}
+
+		return ((FPlatformTime::Seconds() - Start) / NumIterations) * 1000.0;
+	}
+
+	/**
+	 * Compares the batch clipping distance functions against a scalar loop over the same points. Reports the time of both and the largest
+	 * difference between their results.
+	 */
+	void RunClipping(const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		const int32 NumPoints = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 262144;
+		const int32 NumIterations = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 10;
+
+		FRandomStream Random(0);
+		TArray<float> X, Y, Z, ScalarDistances, BatchDistances;
+		X.SetNumUninitialized(NumPoints);
+		Y.SetNumUninitialized(NumPoints);
+		Z.SetNumUninitialized(NumPoints);
+		ScalarDistances.SetNumUninitialized(NumPoints);
+		BatchDistances.SetNumUninitialized(NumPoints);
+
+		for (int32 Index = 0; Index < NumPoints; ++Index)
+		{
+			X[Index] = Random.FRandRange(-200, 200);
+			Y[Index] = Random.FRandRange(-200, 200);
+			Z[Index] = Random.FRandRange(-200, 200);
+		}
+
+		const FVector4 Plane(FVector(1, 1, 0).GetSafeNormal(), 10);
+		const FMatrix SphereInverseTransform =
+			FTransform(FQuat::Identity, FVector(10, 0, 0), FVector(200, 100, 150)).ToInverseMatrixWithScale();
+		const FMatrix BoxInverseTransform =
+			FTransform(FRotator(30, 45, 0).Quaternion(), FVector(0, 20, 0), FVector(150, 200, 100)).ToInverseMatrixWithScale();
+		const FVector4 ConeStart(0, 0, -50, 80);
+		const FVector4 ConeEnd(0, 0, 100, 20);
+
+		auto Compare = [&](const TCHAR* Name, TFunctionRef<float(const FVector&)> Scalar, TFunctionRef<void()> Batch)
+		{
+			const double ScalarMs = Time(
+				NumIterations,
+				[&]()
+				{
+					for (int32 Index = 0; Index < NumPoints; ++Index)
+					{
+						ScalarDistances[Index] = Scalar(FVector(X[Index], Y[Index], Z[Index]));
+					}
+				});
+			const double BatchMs = Time(NumIterations, Batch);
+
+			float MaxError = 0;
+
+			for (int32 Index = 0; Index < NumPoints; ++Index)
+			{
+				MaxError = FMath::Max(MaxError, FMath::Abs(ScalarDistances[Index] - BatchDistances[Index]));
+			}
+
+			Ar.Logf(
+				TEXT("GraphicsTools.BenchmarkClipping %s: %d points, scalar %.3fms, batch %.3fms (%.1fx), max error %f."), Name, NumPoints,
+				ScalarMs, BatchMs, ScalarMs / FMath::Max(BatchMs, UE_DOUBLE_SMALL_NUMBER), MaxError);
+		};
+
+		Compare(
+			TEXT("Plane"), [&](const FVector& Point) { return UGTClippingFunctionLibrary::PointVsPlane(Point, Plane, 1); },
+			[&]() { UGTClippingFunctionLibrary::PointsVsPlane(X, Y, Z, Plane, 1, BatchDistances); });
+		Compare(
+			TEXT("Sphere"),
+			[&](const FVector& Point) { return UGTClippingFunctionLibrary::PointVsSphere(Point, SphereInverseTransform, 1); },
+			[&]() { UGTClippingFunctionLibrary::PointsVsSphere(X, Y, Z, SphereInverseTransform, 1, BatchDistances); });
+		Compare(
+			TEXT("Box"), [&](const FVector& Point) { return UGTClippingFunctionLibrary::PointVsBox(Point, BoxInverseTransform, 1); },
+			[&]() { UGTClippingFunctionLibrary::PointsVsBox(X, Y, Z, BoxInverseTransform, 1, BatchDistances); });
+		Compare(
+			TEXT("Cone"), [&](const FVector& Point) { return UGTClippingFunctionLibrary::PointVsCone(Point, ConeStart, ConeEnd, 1); },
+			[&]() { UGTClippingFunctionLibrary::PointsVsCone(X, Y, Z, ConeStart, ConeEnd, 1, BatchDistances); });
+	}
+} // namespace GTBenchmark
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GTBenchmarkCommand(
+	TEXT("GraphicsTools.Benchmark"),
+	TEXT("Stress tests Graphics Tools components and reports time and MPC writes per frame against the GraphicsTools.Benchmark budgets. ")
+		TEXT("Usage: GraphicsTools.Benchmark [NumProximityLights=1024] [NumClippingPrimitives=1024] [NumFrames=60]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&GTBenchmark::RunCommand));
+
+static FAutoConsoleCommandWithArgsAndOutputDevice GTBenchmarkClippingCommand(
+	TEXT("GraphicsTools.BenchmarkClipping"),
+	TEXT("Compares the batch clipping primitive distance functions against a scalar loop. ")
+		TEXT("Usage: GraphicsTools.BenchmarkClipping [NumPoints=262144] [NumIterations=10]"),
+	FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&GTBenchmark::RunClipping));
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FGTBenchmarkTest, "GraphicsTools.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter);
+
+bool FGTBenchmarkTest::RunTest(const FString& Parameters)
+{
+	// Run within a transient game world so that the results do not depend on the loaded level.
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	const bool Passed = GTBenchmark::Run(World, 1024, 1024, 60, *GLog);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	TestTrue(TEXT("GraphicsTools.Benchmark is within the frame, write and skipped transform update budgets"), Passed);
+	return Passed;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,7 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "Modules/ModuleManager.h"
+
+// Benchmarks and automation tests for the Graphics Tools runtime module, kept out of shipping builds.
+IMPLEMENT_MODULE(FDefaultModuleImpl, GraphicsToolsTests);